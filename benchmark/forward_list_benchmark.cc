@@ -0,0 +1,79 @@
+// -*- C++ -*-
+//===---------------------- forward list benchmark ------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "list/list.h"
+#include "forward_list/forward_list.h"
+
+namespace {
+const int kElements = 1000000;
+
+size_t g_allocated_bytes = 0;
+
+//  ft::Allocator that sums the bytes its containers ask for
+template<class T>
+class SizeAllocator : public ft::Allocator<T> {
+ public:
+  template<class U>
+  struct rebind { typedef SizeAllocator<U> other; };
+
+  SizeAllocator() noexcept = default;
+  template<class U>
+  explicit SizeAllocator(const SizeAllocator<U> &) noexcept {}
+
+  T *allocate(size_t size, const void * = nullptr) {
+    g_allocated_bytes += size * sizeof(T);
+    return ft::Allocator<T>::allocate(size);
+  }
+};
+
+template<class List>
+void memory_per_element(const string &name) {
+  g_allocated_bytes = 0;
+  List lst;
+  for (int i = 0; i < kElements; ++i) {
+    lst.push_front(i);
+  }
+  cout << name << ": " << static_cast<double>(g_allocated_bytes) / kElements
+       << " bytes per element" << endl;
+}
+
+template<class List>
+void push_front_and_sort(const string &name) {
+  List lst;
+  {
+    LOG_DURATION(name + " push_front")
+    for (int i = 0; i < kElements; ++i) {
+      lst.push_front(static_cast<int>(i * 7919LL % kElements));
+    }
+  }
+  long long sum = 0;
+  {
+    LOG_DURATION(name + " traverse")
+    for (auto it = lst.begin(); it != lst.end(); ++it) {
+      sum += *it;
+    }
+  }
+  {
+    LOG_DURATION(name + " sort")
+    lst.sort();
+  }
+  cout << name << " sum: " << sum << ", front: " << lst.front() << endl;
+}
+}
+
+int main() {
+  memory_per_element<ft::list<int, SizeAllocator<int> > >("ft::list<int>");
+  memory_per_element<ft::forward_list<int, SizeAllocator<int> > >(
+      "ft::forward_list<int>");
+  push_front_and_sort<ft::list<int> >("ft::list");
+  push_front_and_sort<ft::forward_list<int> >("ft::forward_list");
+  push_front_and_sort<ft::forward_list<int, ft::PoolAllocator<int> > >(
+      "ft::forward_list (pooled)");
+}
@@ -0,0 +1,54 @@
+// -*- C++ -*-
+//===------------------------ huge page benchmark -------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <cstdint>
+#include "tools/profile.h"
+#include "vector/vector.h"
+
+namespace {
+//  1 GiB of 64-bit values, far more than the TLB covers with 4 KiB pages
+const size_t kElements = size_t(1) << 27;
+const size_t kLookups = size_t(1) << 25;
+const size_t kChainedLookups = size_t(1) << 22;
+
+//  dependent random reads: every index comes from the value before, so each
+//  miss in the TLB costs a full page walk
+template<class Vector>
+void random_reads(const string &name) {
+  Vector v(kElements, ft::default_init);
+  uint64_t state = 88172645463325252ull;
+  for (size_t i = 0; i < kElements; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    v[i] = state;
+  }
+  uint64_t index = 0;
+  {
+    LOG_DURATION(name + " dependent random reads")
+    for (size_t i = 0; i < kChainedLookups; ++i) {
+      index = v[index & (kElements - 1)];
+    }
+  }
+  uint64_t total = 0;
+  {
+    LOG_DURATION(name + " independent random reads")
+    for (size_t i = 0; i < kLookups; ++i) {
+      total += v[(i * 0x9E3779B97F4A7C15ull >> 17) & (kElements - 1)];
+    }
+  }
+  cout << index + total << endl;
+}
+}
+
+int main() {
+  random_reads<ft::vector<uint64_t> >("ft::Allocator");
+  random_reads<ft::vector<uint64_t, ft::HugePageAllocator<uint64_t> > >(
+      "ft::HugePageAllocator");
+}
@@ -0,0 +1,99 @@
+// -*- C++ -*-
+//===----------------------- index list benchmark -------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include "tools/profile.h"
+#include "list/list.h"
+#include "list/index_list.h"
+
+namespace {
+const int kElements = 1000000;
+
+size_t g_allocated_bytes = 0;
+
+//  ft::Allocator that sums the bytes its containers ask for
+template<class T>
+class SizeAllocator : public ft::Allocator<T> {
+ public:
+  template<class U>
+  struct rebind { typedef SizeAllocator<U> other; };
+
+  SizeAllocator() noexcept = default;
+  template<class U>
+  explicit SizeAllocator(const SizeAllocator<U> &) noexcept {}
+
+  T *allocate(size_t size, const void * = nullptr) {
+    g_allocated_bytes += size * sizeof(T);
+    return ft::Allocator<T>::allocate(size);
+  }
+};
+
+template<class List>
+void memory_per_element(List &lst, const string &name) {
+  for (int i = 0; i < kElements; ++i) {
+    lst.push_back(i);
+  }
+  cout << name << ": " << static_cast<double>(g_allocated_bytes) / kElements
+       << " bytes per element" << endl;
+}
+
+template<class List>
+void traverse(const List &lst, const string &name) {
+  long long sum = 0;
+  {
+    LOG_DURATION(name + " traverse")
+    for (int pass = 0; pass < 10; ++pass) {
+      for (auto it = lst.begin(); it != lst.end(); ++it) {
+        sum += *it;
+      }
+    }
+  }
+  cout << name << " sum: " << sum << endl;
+}
+
+//  relinks the nodes in random order, so list order no longer matches the
+//  order of the slots in memory
+void shuffle(ft::index_list<int> &lst) {
+  std::vector<ft::index_list<int>::iterator> order;
+  for (auto it = lst.begin(); it != lst.end(); ++it) {
+    order.push_back(it);
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  for (size_t i = 0; i < order.size(); ++i) {
+    lst.splice(lst.end(), lst, order[i]);
+  }
+}
+}
+
+int main() {
+  {
+    ft::list<int, SizeAllocator<int> > lst;
+    ft::index_list<int, SizeAllocator<int> > index;
+    memory_per_element(lst, "ft::list");
+    g_allocated_bytes = 0;
+    index.reserve(kElements);
+    memory_per_element(index, "ft::index_list");
+  }
+  ft::list<int> lst;
+  ft::index_list<int> index;
+  for (int i = 0; i < kElements; ++i) {
+    lst.push_back(i);
+    index.push_back(i);
+  }
+  traverse(lst, "ft::list");
+  traverse(index, "ft::index_list");
+  shuffle(index);
+  traverse(index, "ft::index_list shuffled");
+  {
+    LOG_DURATION("ft::index_list compact")
+    index.compact();
+  }
+  traverse(index, "ft::index_list compacted");
+}
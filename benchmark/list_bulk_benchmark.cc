@@ -0,0 +1,96 @@
+// -*- C++ -*-
+//===------------------------ list bulk benchmark -------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "list/list.h"
+
+namespace {
+const int kElements = 1000000;
+const int kRefills = 20;
+
+size_t g_allocations = 0;
+
+//  ft::Allocator that counts the calls to allocate
+template<class T>
+class CallAllocator : public ft::Allocator<T> {
+ public:
+  template<class U>
+  struct rebind { typedef CallAllocator<U> other; };
+
+  CallAllocator() noexcept = default;
+  template<class U>
+  CallAllocator(const CallAllocator<U> &) noexcept {}
+
+  T *allocate(size_t size, const void * = nullptr) {
+    ++g_allocations;
+    return ft::Allocator<T>::allocate(size);
+  }
+};
+
+template<class List>
+void bulk(const string &name) {
+  std::vector<int> values(kElements, 1);
+  g_allocations = 0;
+  {
+    LOG_DURATION(name + " fill, insert range, resize, destroy")
+    List lst(kElements, 0);
+    lst.insert(lst.begin(), values.begin(), values.end());
+    lst.resize(3 * kElements);
+  }
+  cout << name << ": " << g_allocations << " allocations" << endl;
+}
+
+//  refills a long-lived list with sizes that drift around kElements
+template<class List>
+void refill(const string &name) {
+  List lst(kElements, 0);
+  List source(kElements, 1);
+  g_allocations = 0;
+  {
+    LOG_DURATION(name + " refill")
+    for (int i = 0; i < kRefills; ++i) {
+      lst.assign(kElements - i * 1000, i);
+      lst = source;
+    }
+  }
+  cout << name << ": " << g_allocations << " allocations in refill" << endl;
+}
+
+//  erases one element at a time from a filled list, then from one that mixes
+//  block nodes with nodes allocated alone
+template<class List>
+void drain(const string &name) {
+  {
+    List lst(kElements, 0);
+    LOG_DURATION(name + " pop_front after fill")
+    while (!lst.empty()) {
+      lst.pop_front();
+    }
+  }
+  List lst(kElements, 0);
+  List single;
+  for (int i = 0; i < kElements; ++i) {
+    single.push_back(i);
+  }
+  lst.splice(lst.end(), single);
+  LOG_DURATION(name + " pop_back, mixed nodes")
+  while (!lst.empty()) {
+    lst.pop_back();
+  }
+}
+}
+
+int main() {
+  bulk<std::list<int, CallAllocator<int> > >("std::list");
+  bulk<ft::list<int, CallAllocator<int> > >("ft::list");
+  refill<std::list<int, CallAllocator<int> > >("std::list");
+  refill<ft::list<int, CallAllocator<int> > >("ft::list");
+  drain<std::list<int> >("std::list");
+  drain<ft::list<int> >("ft::list");
+}
@@ -0,0 +1,59 @@
+// -*- C++ -*-
+//===----------------------- list compact benchmark -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include "tools/profile.h"
+#include "list/list.h"
+
+namespace {
+const int kElements = 1000000;
+const int kPasses = 10;
+
+void traverse(const ft::list<int> &lst, const string &name) {
+  long long sum = 0;
+  {
+    LOG_DURATION(name + " traverse")
+    for (int pass = 0; pass < kPasses; ++pass) {
+      for (auto it = lst.begin(); it != lst.end(); ++it) {
+        sum += *it;
+      }
+    }
+  }
+  cout << name << " sum: " << sum << endl;
+}
+
+//  relinks the nodes in random order, so list order no longer matches the
+//  order the nodes were allocated in
+void shuffle(ft::list<int> &lst) {
+  std::vector<ft::list<int>::iterator> order;
+  for (auto it = lst.begin(); it != lst.end(); ++it) {
+    order.push_back(it);
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  for (size_t i = 0; i < order.size(); ++i) {
+    lst.splice(lst.end(), lst, order[i]);
+  }
+}
+}
+
+int main() {
+  ft::list<int> lst;
+  for (int i = 0; i < kElements; ++i) {
+    lst.push_back(i);
+  }
+  traverse(lst, "ft::list");
+  shuffle(lst);
+  traverse(lst, "ft::list shuffled");
+  {
+    LOG_DURATION("ft::list compact")
+    lst.compact();
+  }
+  traverse(lst, "ft::list compacted");
+}
@@ -0,0 +1,70 @@
+// -*- C++ -*-
+//===------------------------ list merge benchmark ------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "list/list.h"
+
+namespace {
+const int kElements = 1000000;
+
+long long g_compares = 0;
+
+bool counting_less(int a, int b) {
+  ++g_compares;
+  return a < b;
+}
+
+//  merges two sorted lists of kElements whose ranges share 'overlap' values
+template<class List>
+void merge(const string &name, int overlap) {
+  List a;
+  List b;
+  for (int i = 0; i < kElements; ++i) {
+    a.push_back(i);
+    b.push_back(kElements - overlap + i);
+  }
+  g_compares = 0;
+  {
+    LOG_DURATION(name + " merge, overlap " + to_string(overlap))
+    a.merge(b, counting_less);
+  }
+  cout << name << ": " << g_compares << " compares, size " << a.size()
+       << endl;
+}
+
+//  interleaves runs of 'run' elements from each list
+template<class List>
+void merge_runs(const string &name, int run) {
+  List a;
+  List b;
+  for (int i = 0; i < kElements; ++i) {
+    (i / run % 2 ? b : a).push_back(i);
+  }
+  g_compares = 0;
+  {
+    LOG_DURATION(name + " merge, runs of " + to_string(run))
+    a.merge(b, counting_less);
+  }
+  cout << name << ": " << g_compares << " compares, size " << a.size()
+       << endl;
+}
+}
+
+int main() {
+  merge<std::list<int> >("std::list", 0);
+  merge<ft::list<int> >("ft::list", 0);
+  merge<std::list<int> >("std::list", 1000);
+  merge<ft::list<int> >("ft::list", 1000);
+  merge<std::list<int> >("std::list", kElements);
+  merge<ft::list<int> >("ft::list", kElements);
+  merge_runs<std::list<int> >("std::list", 1000);
+  merge_runs<ft::list<int> >("ft::list", 1000);
+  merge_runs<std::list<int> >("std::list", 1);
+  merge_runs<ft::list<int> >("ft::list", 1);
+}
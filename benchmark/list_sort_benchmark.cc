@@ -0,0 +1,66 @@
+// -*- C++ -*-
+//===------------------------- list sort benchmark ------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include "tools/profile.h"
+#include "list/list.h"
+
+namespace {
+const int kSizes[] = {1000, 100000, 1000000};
+
+struct Record {
+  int key;
+  char payload[60];
+};
+
+bool operator<(const Record &a, const Record &b) {
+  return a.key < b.key;
+}
+
+template<class List>
+void fill(List &lst, int n) {
+  std::mt19937 random(42);
+  for (int i = 0; i < n; ++i) {
+    Record r;
+    r.key = static_cast<int>(random());
+    lst.push_back(r);
+  }
+}
+
+//  std::list::sort is the pointer-chasing merge sort ft::list used before
+void sort_std(int n) {
+  std::list<Record> lst;
+  fill(lst, n);
+  LOG_DURATION("std::list sort, " + to_string(n))
+  lst.sort();
+}
+
+void sort_ft(int n) {
+  ft::list<Record> lst;
+  fill(lst, n);
+  LOG_DURATION("ft::list sort, " + to_string(n))
+  lst.sort();
+}
+
+void sort_ft_by_key(int n) {
+  ft::list<Record> lst;
+  fill(lst, n);
+  LOG_DURATION("ft::list sort_by_key, " + to_string(n))
+  lst.sort_by_key([](const Record &r) { return r.key; });
+}
+}
+
+int main() {
+  for (int n : kSizes) {
+    sort_std(n);
+    sort_ft(n);
+    sort_ft_by_key(n);
+  }
+}
@@ -0,0 +1,47 @@
+// -*- C++ -*-
+//===------------------------ list splice benchmark -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "list/list.h"
+
+namespace {
+const int kElements = 1000000;
+const int kSplices = 100;
+
+typedef ft::list<int> eager_list;
+typedef ft::list<int, ft::Allocator<int>, ft::list_lazy_size> lazy_list;
+
+//  moves everything but the first element back and forth between two lists
+template<class List>
+void splice_range(const string &name, bool counted) {
+  List a(kElements + 1, 1);
+  List b(1, 2);
+  {
+    LOG_DURATION(name + " splice")
+    for (int i = 0; i < kSplices; ++i) {
+      List &from = i % 2 ? b : a;
+      List &to = i % 2 ? a : b;
+      if (counted) {
+        to.splice(to.end(), from, std::next(from.begin()), from.end(),
+                  kElements);
+      } else {
+        to.splice(to.end(), from, std::next(from.begin()), from.end());
+      }
+    }
+  }
+  LOG_DURATION(name + " size")
+  cout << name << " sizes: " << a.size() << " " << b.size() << endl;
+}
+}
+
+int main() {
+  splice_range<eager_list>("ft::list", false);
+  splice_range<eager_list>("ft::list counted", true);
+  splice_range<lazy_list>("ft::list lazy size", false);
+}
@@ -0,0 +1,58 @@
+// -*- C++ -*-
+//===----------------------- parallel sort benchmark ----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include "tools/profile.h"
+#include "tools/parallel_sort.h"
+
+namespace {
+const int kVectorElements = 10000000;
+const int kListElements = 2000000;
+const size_t kThreads[] = {1, 2, 4, 8};
+
+void sort_vector(size_t threads) {
+  std::mt19937 random(42);
+  ft::vector<int> v;
+  v.reserve(kVectorElements);
+  for (int i = 0; i < kVectorElements; ++i) {
+    v.push_back(static_cast<int>(random()));
+  }
+  {
+    LOG_DURATION("ft::vector parallel_sort, threads " + to_string(threads))
+    ft::parallel_sort(v, threads);
+  }
+  cout << "sorted: " << std::is_sorted(v.data(), v.data() + v.size())
+       << endl;
+}
+
+void sort_list(size_t threads) {
+  std::mt19937 random(42);
+  ft::list<int> lst;
+  for (int i = 0; i < kListElements; ++i) {
+    lst.push_back(static_cast<int>(random()));
+  }
+  {
+    LOG_DURATION("ft::list parallel_sort, threads " + to_string(threads))
+    ft::parallel_sort(lst, threads);
+  }
+  cout << "sorted: " << std::is_sorted(lst.begin(), lst.end()) << endl;
+}
+}
+
+int main() {
+  cout << "hardware threads: " << std::thread::hardware_concurrency() << endl;
+  for (size_t threads : kThreads) {
+    sort_vector(threads);
+  }
+  for (size_t threads : kThreads) {
+    sort_list(threads);
+  }
+}
@@ -0,0 +1,88 @@
+// -*- C++ -*-
+//===------------------------------ pmr benchmark -------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "tools/memory_resource.h"
+#include "vector/vector.h"
+#include "list/list.h"
+
+namespace {
+const int kRounds = 20000;
+const int kNodes = 200;
+
+//  a request-shaped workload: every round builds a few short lived
+//  containers and throws them all away at once
+template<class List, class Vector>
+long long request(const typename List::allocator_type &list_alloc,
+                  const typename Vector::allocator_type &vector_alloc) {
+  long long sum = 0;
+  List lst(list_alloc);
+  for (int i = 0; i < kNodes; ++i) {
+    lst.push_back(i);
+  }
+  for (int i = 0; i < 8; ++i) {
+    Vector v(vector_alloc);
+    for (int k = 0; k < 16 << (i % 4); ++k) {
+      v.push_back(k);
+    }
+    sum += v.back();
+  }
+  return sum + lst.back();
+}
+
+void with_allocator() {
+  typedef ft::list<int, ft::Allocator<int> > list_type;
+  typedef ft::vector<int, ft::Allocator<int> > vector_type;
+  long long sum = 0;
+  {
+    LOG_DURATION("ft::Allocator")
+    for (int r = 0; r < kRounds; ++r) {
+      sum += request<list_type, vector_type>(ft::Allocator<int>(),
+                                             ft::Allocator<int>());
+    }
+  }
+  cout << sum << endl;
+}
+
+void with_monotonic() {
+  long long sum = 0;
+  {
+    LOG_DURATION("monotonic_buffer_resource")
+    char buffer[1 << 16];
+    for (int r = 0; r < kRounds; ++r) {
+      ft::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+      sum += request<ft::pmr::list<int>, ft::pmr::vector<int> >(&arena,
+                                                                 &arena);
+    }
+  }
+  cout << sum << endl;
+}
+
+void with_pool() {
+  long long sum = 0;
+  {
+    LOG_DURATION("unsynchronized_pool_resource")
+    ft::pmr::unsynchronized_pool_resource pool;
+    for (int r = 0; r < kRounds; ++r) {
+      sum += request<ft::pmr::list<int>, ft::pmr::vector<int> >(&pool,
+                                                                 &pool);
+    }
+  }
+  cout << sum << endl;
+}
+}
+
+int main() {
+  with_allocator();
+  with_monotonic();
+  with_pool();
+  with_allocator();
+  with_monotonic();
+  with_pool();
+}
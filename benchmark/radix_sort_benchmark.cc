@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//===------------------------ radix sort benchmark ------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include "tools/profile.h"
+#include "tools/radix_sort.h"
+
+namespace {
+const size_t kSizes[] = {1000, 100000, 10000000, 100000000};
+
+struct Record {
+  uint32_t key;
+  uint32_t payload[3];
+};
+
+template<class T, class Generator>
+void fill(ft::vector<T> &v, size_t n, Generator generate) {
+  std::mt19937_64 random(42);
+  v.clear();
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    v.push_back(generate(random));
+  }
+}
+
+//  sorts the same random input with std::sort and ft::radix_sort
+template<class T, class Generator>
+void compare(const string &name, size_t n, Generator generate) {
+  ft::vector<T> v;
+  fill(v, n, generate);
+  {
+    LOG_DURATION("std::sort " + name + ", " + to_string(n))
+    std::sort(v.data(), v.data() + n);
+  }
+  fill(v, n, generate);
+  {
+    LOG_DURATION("ft::radix_sort " + name + ", " + to_string(n))
+    ft::radix_sort(v);
+  }
+  cout << "sorted: " << std::is_sorted(v.data(), v.data() + n) << endl;
+}
+
+void compare_records(size_t n) {
+  ft::vector<Record> v;
+  auto generate = [](std::mt19937_64 &random) {
+    Record r = {static_cast<uint32_t>(random()), {0, 0, 0}};
+    return r;
+  };
+  auto by_key = [](const Record &a, const Record &b) {
+    return a.key < b.key;
+  };
+  fill(v, n, generate);
+  {
+    LOG_DURATION("std::sort records, " + to_string(n))
+    std::sort(v.data(), v.data() + n, by_key);
+  }
+  fill(v, n, generate);
+  {
+    LOG_DURATION("ft::radix_sort records, " + to_string(n))
+    ft::radix_sort(v, [](const Record &r) { return r.key; });
+  }
+  cout << "sorted: " << std::is_sorted(v.data(), v.data() + n, by_key)
+       << endl;
+}
+}
+
+int main() {
+  for (size_t n : kSizes) {
+    compare<uint32_t>("uint32", n, [](std::mt19937_64 &random) {
+      return static_cast<uint32_t>(random());
+    });
+    compare<int64_t>("int64", n, [](std::mt19937_64 &random) {
+      return static_cast<int64_t>(random());
+    });
+    compare<int32_t>("int32 below 2^16", n, [](std::mt19937_64 &random) {
+      return static_cast<int32_t>(random() % 65536);
+    });
+    compare<float>("float", n, [](std::mt19937_64 &random) {
+      return static_cast<float>(static_cast<int32_t>(random())) / 3.0f;
+    });
+    compare_records(n);
+  }
+}
@@ -0,0 +1,190 @@
+// -*- C++ -*-
+//===----------------------- sized delete benchmark -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "tools/profile.h"
+#include "vector/vector.h"
+#include "list/list.h"
+
+//  A stand-in for a size-class malloc such as tcmalloc or mimalloc, installed
+//  as the global operator new.  Blocks up to kMaxSmall bytes are carved out
+//  of kSpan aligned spans and kept on one free list per class.  A sized
+//  delete gets the class straight from the size; an unsized one has to look
+//  the span up in a two level page map first, as those allocators do.
+//  The benchmark is single threaded, so nothing here is locked.
+namespace {
+const size_t kMinSmall = 16;
+const size_t kClasses = 7;
+const size_t kMaxSmall = kMinSmall << (kClasses - 1);
+const int kSpanShift = 16;
+const size_t kSpan = size_t(1) << kSpanShift;
+const int kLeafBits = 16;
+const int kRootBits = 48 - kSpanShift - kLeafBits;
+
+struct FreeBlock {
+  FreeBlock *next_;
+};
+
+FreeBlock *free_lists[kClasses];
+unsigned char *page_map[size_t(1) << kRootBits];
+
+size_t size_class(size_t bytes) {
+  size_t c = 0;
+  while ((kMinSmall << c) < bytes) {
+    ++c;
+  }
+  return c;
+}
+
+//  0 means the block did not come from a span
+size_t span_class(void *p) {
+  uintptr_t span = reinterpret_cast<uintptr_t>(p) >> kSpanShift;
+  unsigned char *leaf = page_map[span >> kLeafBits];
+  return leaf ? leaf[span & ((size_t(1) << kLeafBits) - 1)] : 0;
+}
+
+void refill(size_t c) {
+  void *block = nullptr;
+  if (posix_memalign(&block, kSpan, kSpan)) {
+    throw std::bad_alloc();
+  }
+  char *span = static_cast<char *>(block);
+  uintptr_t index = reinterpret_cast<uintptr_t>(span) >> kSpanShift;
+  unsigned char *&leaf = page_map[index >> kLeafBits];
+  if (!leaf) {
+    leaf = static_cast<unsigned char *>(
+        std::calloc(size_t(1) << kLeafBits, 1));
+  }
+  leaf[index & ((size_t(1) << kLeafBits) - 1)]
+      = static_cast<unsigned char>(c + 1);
+  size_t bytes = kMinSmall << c;
+  for (size_t offset = kSpan; offset >= bytes; offset -= bytes) {
+    FreeBlock *block = reinterpret_cast<FreeBlock *>(span + offset - bytes);
+    block->next_ = free_lists[c];
+    free_lists[c] = block;
+  }
+}
+
+//  blocks above kMaxSmall bytes live in malloc; kept out of line so the
+//  compiler does not pair free() with the operator new it sits in
+__attribute__((noinline)) void release_large(void *p) {
+  std::free(p);
+}
+
+void release(void *p, size_t c) {
+  FreeBlock *block = static_cast<FreeBlock *>(p);
+  block->next_ = free_lists[c];
+  free_lists[c] = block;
+}
+}
+
+void *operator new(size_t bytes) {
+  if (bytes > kMaxSmall) {
+    void *p = std::malloc(bytes);
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+  size_t c = size_class(bytes ? bytes : 1);
+  if (!free_lists[c]) {
+    refill(c);
+  }
+  FreeBlock *block = free_lists[c];
+  free_lists[c] = block->next_;
+  return block;
+}
+
+void operator delete(void *p) noexcept {
+  if (!p) {
+    return;
+  }
+  size_t c = span_class(p);
+  if (!c) {
+    release_large(p);
+    return;
+  }
+  release(p, c - 1);
+}
+
+void operator delete(void *p, size_t bytes) noexcept {
+  if (bytes > kMaxSmall) {
+    release_large(p);
+    return;
+  }
+  release(p, size_class(bytes ? bytes : 1));
+}
+
+namespace {
+const int kQueue = 64;
+const int kOperations = 1 << 23;
+const int kVectors = 1 << 19;
+
+//  ft::Allocator without the size on the way out, the way it was before
+//  it forwarded sized delete
+template<class T>
+class UnsizedAllocator : public ft::Allocator<T> {
+ public:
+  template<class U>
+  struct rebind { typedef UnsizedAllocator<U> other; };
+
+  UnsizedAllocator() noexcept = default;
+  template<class U>
+  UnsizedAllocator(const UnsizedAllocator<U> &) noexcept {}
+
+  void deallocate(T *p, size_t size) const noexcept {
+    if (size * sizeof(T) >= ft::memory_detail::kMapThreshold) {
+      ft::Allocator<T>::deallocate(p, size);
+      return;
+    }
+    ::operator delete(p);
+  }
+};
+
+//  a short list used as a queue frees a node on every step, so the cost of
+//  operator delete is most of what is measured
+template<template<class> class Alloc>
+void churn(const string &name) {
+  typedef ft::list<long, Alloc<long> > list_type;
+  typedef ft::vector<long, Alloc<long> > vector_type;
+  long long sum = 0;
+  {
+    LOG_DURATION(name + " list churn")
+    list_type queue;
+    for (int i = 0; i < kQueue; ++i) {
+      queue.push_back(i);
+    }
+    for (int i = 0; i < kOperations; ++i) {
+      sum += queue.front();
+      queue.pop_front();
+      queue.push_back(i);
+    }
+  }
+  {
+    LOG_DURATION(name + " vector churn")
+    for (int i = 0; i < kVectors; ++i) {
+      vector_type v;
+      for (int k = 0; k < 1 + i % 64; ++k) {
+        v.push_back(k);
+      }
+      sum += v.back();
+    }
+  }
+  cout << sum << endl;
+}
+}
+
+int main() {
+  churn<UnsizedAllocator>("unsized delete");
+  churn<ft::Allocator>("sized delete");
+  churn<UnsizedAllocator>("unsized delete");
+  churn<ft::Allocator>("sized delete");
+}
@@ -0,0 +1,73 @@
+// -*- C++ -*-
+//===----------------------- thread cache benchmark -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <thread>
+#include "tools/profile.h"
+#include "vector/vector.h"
+#include "list/list.h"
+
+namespace {
+const int kThreads = 4;
+const int kRounds = 2000;
+const int kNodes = 500;
+
+//  every worker builds lists and small vectors; every other list is swapped
+//  into a shared slot, so it is destroyed by whichever thread takes it next
+template<template<class> class Alloc>
+void churn(const string &name) {
+  typedef ft::list<int, Alloc<int> > list_type;
+  typedef ft::vector<int, Alloc<int> > vector_type;
+  std::mutex mutex;
+  list_type shared;
+  long long total = 0;
+  {
+    LOG_DURATION(name + " churn")
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        long long sum = 0;
+        for (int r = 0; r < kRounds; ++r) {
+          list_type lst;
+          for (int i = 0; i < kNodes; ++i) {
+            lst.push_back(i + t);
+          }
+          for (int i = 0; i < 8; ++i) {
+            vector_type v;
+            for (int k = 0; k < 16 << (i % 4); ++k) {
+              v.push_back(k);
+            }
+            sum += v.back();
+          }
+          if (r % 2) {
+            std::lock_guard<std::mutex> lock(mutex);
+            shared.swap(lst);
+          }
+          sum += lst.size();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        total += sum;
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+  cout << total << endl;
+}
+
+template<class T>
+using pool = ft::PoolAllocator<T>;
+}
+
+int main() {
+  churn<ft::Allocator>("ft::Allocator");
+  churn<pool>("ft::PoolAllocator");
+  churn<ft::ThreadCacheAllocator>("ft::ThreadCacheAllocator");
+}
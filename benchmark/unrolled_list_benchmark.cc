@@ -0,0 +1,94 @@
+// -*- C++ -*-
+//===---------------------- unrolled list benchmark -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "list/list.h"
+#include "list/unrolled_list.h"
+
+namespace {
+const int kElements = 1000000;
+const int kMiddleInserts = 100000;
+const int kSplices = 20;
+
+template<class List>
+void push_back(List &lst, const string &name) {
+  LOG_DURATION(name + " push_back")
+  for (int i = 0; i < kElements; ++i) {
+    lst.push_back(i);
+  }
+}
+
+template<class List>
+void traverse(const List &lst, const string &name) {
+  long long sum = 0;
+  {
+    LOG_DURATION(name + " traverse")
+    for (auto it = lst.begin(); it != lst.end(); ++it) {
+      sum += *it;
+    }
+  }
+  cout << name << " sum: " << sum << endl;
+}
+
+template<class List>
+void insert_every_other(List &lst, const string &name) {
+  LOG_DURATION(name + " insert every other")
+  int inserted = 0;
+  for (auto it = lst.begin(); it != lst.end() && inserted < kMiddleInserts;
+       ++inserted) {
+    it = lst.insert(it, -1);
+    ++it;
+    ++it;
+  }
+}
+
+//  moves the back half of 'lst' to another list and back, counting the
+//  range each time and then passing the count that is already known
+template<class List>
+void range_splice(List &lst, const string &name) {
+  List other;
+  const size_t n = lst.size() - lst.size() / 2;
+  auto middle = std::next(lst.begin(), lst.size() / 2);
+  other.splice(other.end(), lst, middle, lst.end());
+  //  an iterator to a node start, so later splices leave it valid
+  middle = other.begin();
+  lst.splice(lst.end(), other);
+  {
+    LOG_DURATION(name + " range splice")
+    for (int i = 0; i < kSplices; ++i) {
+      other.splice(other.end(), lst, middle, lst.end());
+      lst.splice(lst.end(), other, other.begin(), other.end());
+    }
+  }
+  {
+    LOG_DURATION(name + " counted range splice")
+    for (int i = 0; i < kSplices; ++i) {
+      other.splice(other.end(), lst, middle, lst.end(), n);
+      lst.splice(lst.end(), other, other.begin(), other.end(), n);
+    }
+  }
+}
+}
+
+int main() {
+  ft::list<int> lst;
+  ft::unrolled_list<int> unrolled;
+  push_back(lst, "ft::list");
+  push_back(unrolled, "ft::unrolled_list");
+  traverse(lst, "ft::list");
+  traverse(unrolled, "ft::unrolled_list");
+  insert_every_other(lst, "ft::list");
+  insert_every_other(unrolled, "ft::unrolled_list");
+  traverse(lst, "ft::list");
+  traverse(unrolled, "ft::unrolled_list");
+  range_splice(lst, "ft::list");
+  range_splice(unrolled, "ft::unrolled_list");
+  cout << "ft::unrolled_list nodes: " << unrolled.node_count()
+       << " for " << unrolled.size() << " elements" << endl;
+}
@@ -0,0 +1,96 @@
+// -*- C++ -*-
+//===----------------------- vector append benchmark ----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "vector/vector.h"
+
+namespace {
+const int kElements = 1000000;
+const int kRounds = 50;
+
+//  the sum keeps the appended values from being optimized away
+template<class Vector>
+long long sum(const Vector &v) {
+  long long total = 0;
+  for (size_t i = 0; i < v.size(); i += 4096) {
+    total += v[i];
+  }
+  return total;
+}
+
+template<class Vector>
+void push_back(const string &name) {
+  long long total = 0;
+  {
+    LOG_DURATION(name + " push_back")
+    for (int r = 0; r < kRounds; ++r) {
+      Vector v;
+      for (int i = 0; i < kElements; ++i) {
+        v.push_back(i);
+      }
+      total += sum(v);
+    }
+  }
+  {
+    LOG_DURATION(name + " reserve, push_back")
+    for (int r = 0; r < kRounds; ++r) {
+      Vector v;
+      v.reserve(kElements);
+      for (int i = 0; i < kElements; ++i) {
+        v.push_back(i);
+      }
+      total += sum(v);
+    }
+  }
+  cout << total << endl;
+}
+
+void append() {
+  std::vector<int> source(kElements);
+  for (int i = 0; i < kElements; ++i) {
+    source[i] = i;
+  }
+  long long total = 0;
+  {
+    LOG_DURATION("ft::vector reserve, push_back_unchecked")
+    for (int r = 0; r < kRounds; ++r) {
+      ft::vector<int> v;
+      v.reserve(kElements);
+      for (int i = 0; i < kElements; ++i) {
+        v.push_back_unchecked(i);
+      }
+      total += sum(v);
+    }
+  }
+  {
+    LOG_DURATION("ft::vector append_n")
+    for (int r = 0; r < kRounds; ++r) {
+      ft::vector<int> v;
+      int i = 0;
+      v.append_n(kElements, [&i]() { return i++; });
+      total += sum(v);
+    }
+  }
+  {
+    LOG_DURATION("ft::vector append")
+    for (int r = 0; r < kRounds; ++r) {
+      ft::vector<int> v;
+      v.append(source.begin(), source.end());
+      total += sum(v);
+    }
+  }
+  cout << total << endl;
+}
+}
+
+int main() {
+  push_back<std::vector<int> >("std::vector");
+  push_back<ft::vector<int> >("ft::vector");
+  append();
+}
@@ -0,0 +1,66 @@
+// -*- C++ -*-
+//===----------------------- vector assign benchmark ----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include "tools/profile.h"
+#include "vector/vector.h"
+
+namespace {
+const int kElements = 100000;
+const int kRounds = 200;
+
+size_t g_allocations = 0;
+
+//  ft::Allocator that counts the calls to allocate
+template<class T>
+class CallAllocator : public ft::Allocator<T> {
+ public:
+  template<class U>
+  struct rebind { typedef CallAllocator<U> other; };
+
+  CallAllocator() noexcept = default;
+  template<class U>
+  CallAllocator(const CallAllocator<U> &) noexcept {}
+
+  T *allocate(size_t size, const void * = nullptr) {
+    ++g_allocations;
+    return ft::Allocator<T>::allocate(size);
+  }
+};
+
+//  refills a vector from sources that fit its capacity, then inserts a
+//  range into its middle
+template<class Vector>
+void refill(const string &name, const typename Vector::value_type &value) {
+  typedef typename Vector::value_type value_type;
+  std::vector<value_type> source(kElements, value);
+  std::vector<value_type> chunk(kElements / 100, value);
+  Vector v(kElements, value);
+  v.reserve(2 * kElements);
+  g_allocations = 0;
+  {
+    LOG_DURATION(name + " assign and insert")
+    for (int i = 0; i < kRounds; ++i) {
+      v.assign(source.begin(), source.end() - i);
+      v.assign(kElements - i, value);
+      v.insert(v.begin() + v.size() / 2, chunk.begin(), chunk.end());
+    }
+  }
+  cout << name << ": " << g_allocations << " allocations" << endl;
+}
+}
+
+int main() {
+  refill<ft::vector<int, CallAllocator<int> > >("ft::vector<int>", 1);
+  refill<ft::vector<std::string, CallAllocator<std::string> > >(
+      "ft::vector<string>", "value");
+  refill<ft::vector<std::string, CallAllocator<std::string>,
+                    ft::vector_basic_guarantee> >(
+      "ft::vector<string> basic guarantee", "value");
+}
@@ -0,0 +1,49 @@
+// -*- C++ -*-
+//===----------------------- vector growth benchmark ----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include "tools/profile.h"
+#include "vector/vector.h"
+
+namespace {
+//  1 GiB of ints at the end
+const size_t kElements = size_t(1) << 28;
+
+//  grows by push_back alone, as when the final size is unknown
+template<class Vector>
+void push_back(const string &name) {
+  Vector v;
+  {
+    LOG_DURATION(name + " push_back to 1 GiB")
+    for (size_t i = 0; i < kElements; ++i) {
+      v.push_back(static_cast<int>(i));
+    }
+  }
+  cout << v[kElements / 3] << endl;
+}
+
+//  grows a filled vector by half its size at a time
+template<class Vector>
+void resize(const string &name) {
+  Vector v(kElements / 16, 1);
+  {
+    LOG_DURATION(name + " resize by half to 1 GiB")
+    while (v.size() < kElements) {
+      v.resize(v.size() + v.size() / 2);
+    }
+  }
+  cout << v[kElements / 32] << endl;
+}
+}
+
+int main() {
+  push_back<std::vector<int> >("std::vector");
+  push_back<ft::vector<int> >("ft::vector");
+  resize<std::vector<int> >("std::vector");
+  resize<ft::vector<int> >("ft::vector");
+}
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+//===------------------------ vector init benchmark -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <cstring>
+#include "tools/profile.h"
+#include "vector/vector.h"
+
+namespace {
+const size_t kElements = 1 << 24;
+const int kRounds = 20;
+//  only every page is read back, as from a sparse table
+const size_t kStride = 4096 / sizeof(int);
+
+template<class Vector>
+long long sum(const Vector &v) {
+  long long total = 0;
+  for (size_t i = 0; i < v.size(); i += kStride) {
+    total += v[i];
+  }
+  return total;
+}
+
+//  stands in for read() or a decoder overwriting the whole buffer
+template<class Vector>
+void fill(Vector &v) {
+  std::memset(v.data(), 1, v.size() * sizeof(int));
+}
+
+template<class Vector>
+void value_init(const string &name) {
+  long long total = 0;
+  {
+    LOG_DURATION(name + "(n), sparse reads")
+    for (int r = 0; r < kRounds; ++r) {
+      Vector v(kElements);
+      total += sum(v);
+    }
+  }
+  {
+    Vector v;
+    LOG_DURATION(name + " clear, resize(n), then filled")
+    for (int r = 0; r < kRounds; ++r) {
+      v.clear();
+      v.resize(kElements);
+      fill(v);
+      total += sum(v);
+    }
+  }
+  cout << total << endl;
+}
+
+void default_init() {
+  long long total = 0;
+  {
+    LOG_DURATION("ft::vector(n, default_init), then filled")
+    for (int r = 0; r < kRounds; ++r) {
+      ft::vector<int> v(kElements, ft::default_init);
+      fill(v);
+      total += sum(v);
+    }
+  }
+  {
+    ft::vector<int> v;
+    LOG_DURATION("ft::vector clear, resize_default_init(n), then filled")
+    for (int r = 0; r < kRounds; ++r) {
+      v.clear();
+      v.resize_default_init(kElements);
+      fill(v);
+      total += sum(v);
+    }
+  }
+  cout << total << endl;
+}
+}
+
+int main() {
+  value_init<std::vector<int> >("std::vector");
+  value_init<ft::vector<int> >("ft::vector");
+  default_init();
+}
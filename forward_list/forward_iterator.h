@@ -0,0 +1,91 @@
+// -*- C++ -*-
+//===-------------------------- forward iterator --------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "tools/utility.h"
+
+namespace ft {
+template<typename T, class Node>
+class forward_iterator {
+ public:
+  typedef T iterator_type;
+  typedef std::forward_iterator_tag iterator_category;
+  typedef typename remove_const<T>::type value_type;
+  typedef ptrdiff_t difference_type;
+  typedef typename qualifier_type<T>::pointer pointer;
+  typedef typename qualifier_type<T>::reference reference;
+
+  inline forward_iterator() = default;
+  inline ~forward_iterator() = default;
+  inline explicit forward_iterator(Node *node);
+  inline forward_iterator(forward_iterator<value_type, Node> const &other);
+  inline forward_iterator(forward_iterator<const value_type,
+                                           Node> const &other);
+  inline forward_iterator &operator=(forward_iterator const &other) = default;
+  inline reference operator*() const;
+  inline pointer operator->() const;
+  inline forward_iterator &operator++();
+  inline forward_iterator operator++(int);
+  inline bool operator==(const forward_iterator &x) const;
+  inline bool operator!=(const forward_iterator &x) const;
+  inline Node *base() const;
+ private:
+  Node *node_;
+};
+
+template<typename T, class Node>
+forward_iterator<T, Node>::forward_iterator(Node *node) : node_(node) {}
+
+template<typename T, class Node>
+forward_iterator<T, Node>::
+forward_iterator(const forward_iterator<value_type, Node> &other)
+    : node_(other.base()) {}
+
+template<typename T, class Node>
+forward_iterator<T, Node>::
+forward_iterator(const forward_iterator<const value_type, Node> &other)
+    : node_(other.base()) {}
+
+template<typename T, class Node>
+typename forward_iterator<T, Node>::
+reference forward_iterator<T, Node>::operator*() const {
+  return node_->value_;
+}
+
+template<typename T, class Node>
+typename forward_iterator<T, Node>::
+pointer forward_iterator<T, Node>::operator->() const {
+  return std::addressof(node_->value_);
+}
+
+template<typename T, class Node>
+forward_iterator<T, Node> &forward_iterator<T, Node>::operator++() {
+  node_ = node_->next_;
+  return *this;
+}
+
+template<typename T, class Node>
+forward_iterator<T, Node> forward_iterator<T, Node>::operator++(int) {
+  auto tmp = *this;
+  node_ = node_->next_;
+  return tmp;
+}
+
+template<typename T, class Node>
+Node *forward_iterator<T, Node>::base() const {
+  return node_;
+}
+
+template<typename T, class Node>
+bool forward_iterator<T, Node>::operator==(const forward_iterator &x) const {
+  return node_ == x.node_;
+}
+
+template<typename T, class Node>
+bool forward_iterator<T, Node>::operator!=(const forward_iterator &x) const {
+  return node_ != x.node_;
+}
+
+}
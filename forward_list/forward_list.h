@@ -0,0 +1,871 @@
+// -*- C++ -*-
+//===---------------------------- forward list ----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "tools/memory.h"
+#include "tools/memory_resource.h"
+#include "tools/utility.h"
+#include "forward_iterator.h"
+
+namespace ft {
+
+template<class T, class Alloc = ft::Allocator<T> >
+class forward_list {
+ private:
+  struct Node_;
+/*
+**                                Public Types
+*/
+ public:
+  typedef T value_type;
+  typedef Alloc allocator_type;
+  typedef value_type &reference;
+  typedef const value_type &const_reference;
+  typedef typename std::allocator_traits<Alloc>::pointer pointer;
+  typedef typename std::allocator_traits<Alloc>::const_pointer const_pointer;
+  typedef ft::forward_iterator<T, Node_> iterator;
+  typedef ft::forward_iterator<const T, Node_> const_iterator;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+  typedef typename std::allocator_traits<Alloc>
+      ::template rebind_alloc<Node_> node_alloc_;
+/*
+**                           Public Member Functions
+*/
+  inline forward_list();
+  inline explicit forward_list(const allocator_type &a);
+  inline explicit forward_list(size_type n,
+                               const allocator_type &a = allocator_type());
+  inline forward_list(size_type n,
+                      const value_type &value,
+                      const allocator_type &a = allocator_type());
+  template<class Iter>
+  inline forward_list(Iter first, Iter last,
+                      const allocator_type &a = allocator_type(),
+                      typename std::enable_if
+                          <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline forward_list(const forward_list &x);
+  inline forward_list(forward_list &&x);
+  inline forward_list(const forward_list &x, const allocator_type &a);
+  inline forward_list(forward_list &&x, const allocator_type &a);
+  inline forward_list(std::initializer_list<value_type> l,
+                      const allocator_type &a = allocator_type());
+  inline virtual ~forward_list();
+  inline forward_list &operator=(const forward_list &x);
+  inline forward_list &operator=(forward_list &&x);
+  inline forward_list &operator=(std::initializer_list<value_type> l);
+  template<class Iter>
+  inline void assign(Iter first, Iter last,
+                     typename std::enable_if
+                         <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline void assign(size_type n, const value_type &t);
+  inline void assign(std::initializer_list<value_type> l);
+  inline allocator_type get_allocator() const noexcept;
+  inline iterator before_begin() noexcept;
+  inline const_iterator before_begin() const noexcept;
+  inline iterator begin() noexcept;
+  inline const_iterator begin() const noexcept;
+  inline iterator end() noexcept;
+  inline const_iterator end() const noexcept;
+  inline const_iterator cbefore_begin() const noexcept;
+  inline const_iterator cbegin() const noexcept;
+  inline const_iterator cend() const noexcept;
+  inline bool empty() const noexcept;
+  inline size_type max_size() const noexcept;
+  inline reference front();
+  inline const_reference front() const;
+  template<class... Args>
+  inline void emplace_front(Args &&... args);
+  inline void push_front(const value_type &x);
+  inline void push_front(value_type &&x);
+  inline void pop_front();
+  template<class... Args>
+  inline iterator emplace_after(const_iterator position, Args &&... args);
+  inline iterator insert_after(const_iterator position, const value_type &x);
+  inline iterator insert_after(const_iterator position, value_type &&x);
+  inline iterator insert_after(const_iterator position,
+                               size_type n,
+                               const value_type &x);
+  template<class Iter>
+  iterator insert_after(const_iterator position, Iter first, Iter last,
+                        typename std::enable_if
+                            <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline iterator insert_after(const_iterator position,
+                               std::initializer_list<value_type> il);
+  inline iterator erase_after(const_iterator position);
+  iterator erase_after(const_iterator first, const_iterator last);
+  inline void swap(forward_list &x) noexcept;
+  void resize(size_type sz);
+  void resize(size_type sz, const value_type &c);
+  inline void clear() noexcept;
+  void splice_after(const_iterator position, forward_list &x);
+  inline void splice_after(const_iterator position, forward_list &&x);
+  void splice_after(const_iterator position, forward_list &x,
+                    const_iterator i);
+  inline void splice_after(const_iterator position, forward_list &&x,
+                           const_iterator i);
+  void splice_after(const_iterator position, forward_list &x,
+                    const_iterator first, const_iterator last);
+  inline void splice_after(const_iterator position, forward_list &&x,
+                           const_iterator first, const_iterator last);
+  inline void remove(const value_type &value);
+  template<class Pred>
+  void remove_if(Pred pred);
+  inline void unique();
+  template<class BinaryPredicate>
+  void unique(BinaryPredicate binary_pred);
+  inline void merge(forward_list &x);
+  inline void merge(forward_list &&x);
+  template<class Compare>
+  void merge(forward_list &x, Compare comp);
+  template<class Compare>
+  inline void merge(forward_list &&x, Compare comp);
+  inline void sort();
+  template<class Compare>
+  void sort(Compare comp);
+  void reverse() noexcept;
+ private:
+  struct Node_ {
+    Node_ *next_;
+    value_type value_;
+  };
+  typedef std::allocator_traits<Alloc> alloc_traits_;
+  typedef std::allocator_traits<node_alloc_> node_traits_;
+  Node_ *head_;
+  Alloc alloc_;
+  node_alloc_ n_alloc_;
+ protected:
+  Node_ *get_node_();
+  void put_node_(Node_ *p);
+  void init_head_();
+  template<typename... Args>
+  Node_ *create_node_(Args &&... args);
+  void destroy_node_(Node_ *p);
+  void link_chain_after_(Node_ *position, Node_ *first, Node_ *last);
+  template<class Compare>
+  static Node_ *merge_chains_(Node_ *a, Node_ *b, Compare &comp);
+};
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::Node_ *forward_list<T, Alloc>::get_node_() {
+  return node_traits_::allocate(n_alloc_, 1);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::put_node_(Node_ *p) {
+  node_traits_::deallocate(n_alloc_, p, 1);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::init_head_() {
+  head_ = get_node_();
+  head_->next_ = nullptr;
+}
+
+template<class T, class Alloc>
+template<typename... Args>
+typename forward_list<T, Alloc>::Node_ *forward_list<T, Alloc>::create_node_(
+    Args &&... args) {
+  Node_ *p = get_node_();
+  try {
+    alloc_traits_::construct(alloc_, &p->value_, std::forward<Args>(args) ...);
+  } catch (...) {
+    put_node_(p);
+    throw;
+  }
+  p->next_ = nullptr;
+  return p;
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::destroy_node_(Node_ *p) {
+  alloc_traits_::destroy(alloc_, &p->value_);
+  put_node_(p);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::link_chain_after_(Node_ *position,
+                                               Node_ *first,
+                                               Node_ *last) {
+  last->next_ = position->next_;
+  position->next_ = first;
+}
+
+//  merges two sorted null-terminated chains; 'a' wins ties
+template<class T, class Alloc>
+template<class Compare>
+typename forward_list<T, Alloc>::Node_ *forward_list<T, Alloc>::merge_chains_(
+    Node_ *a, Node_ *b, Compare &comp) {
+  Node_ *result = nullptr;
+  Node_ **tail = &result;
+  while (a && b) {
+    if (comp(b->value_, a->value_)) {
+      *tail = b;
+      b = b->next_;
+    } else {
+      *tail = a;
+      a = a->next_;
+    }
+    tail = &(*tail)->next_;
+  }
+  *tail = a ? a : b;
+  return result;
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list() : head_(), alloc_(), n_alloc_() {
+  init_head_();
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(const allocator_type &a)
+    : head_(), alloc_(a), n_alloc_(a) {
+  init_head_();
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(size_type n, const allocator_type &a)
+    : forward_list(a) {
+  resize(n);
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(size_type n,
+                                     const value_type &value,
+                                     const allocator_type &a)
+    : forward_list(a) {
+  insert_after(cbefore_begin(), n, value);
+}
+
+template<class T, class Alloc>
+template<class Iter>
+forward_list<T, Alloc>::forward_list(Iter first, Iter last,
+                                     const allocator_type &a,
+                                     typename std::enable_if
+                                         <!std::numeric_limits<Iter>::is_specialized>::type *)
+    : forward_list(a) {
+  insert_after(cbefore_begin(), first, last);
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(const forward_list &x)
+    : forward_list(x.begin(), x.end(),
+                   alloc_traits_::select_on_container_copy_construction(
+                       x.alloc_)) {}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(forward_list &&x)
+    : forward_list(x.alloc_) {
+  std::swap(head_, x.head_);
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(const forward_list &x,
+                                     const allocator_type &a)
+    : forward_list(x.begin(), x.end(), a) {}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(forward_list &&x,
+                                     const allocator_type &a)
+    : forward_list(a) {
+  if (alloc_ == x.alloc_) {
+    std::swap(head_, x.head_);
+    return;
+  }
+  insert_after(cbefore_begin(), std::make_move_iterator(x.begin()),
+               std::make_move_iterator(x.end()));
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::forward_list(std::initializer_list<value_type> l,
+                                     const allocator_type &a)
+    : forward_list(l.begin(), l.end(), a) {}
+
+template<class T, class Alloc>
+forward_list<T, Alloc>::~forward_list() {
+  clear();
+  put_node_(head_);
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc> &forward_list<T, Alloc>::operator=(
+    const forward_list &x) {
+  if (this == &x) {
+    return *this;
+  }
+  //  the nodes, the head among them, go back to the allocator that made
+  //  them before it is replaced
+  if (alloc_traits_::propagate_on_container_copy_assignment::value
+      && alloc_ != x.alloc_) {
+    node_alloc_ n_alloc(x.n_alloc_);
+    Node_ *head = node_traits_::allocate(n_alloc, 1);
+    clear();
+    put_node_(head_);
+    head_ = head;
+    head_->next_ = nullptr;
+  }
+  ft::propagate_on_copy_assignment(alloc_, x.alloc_);
+  ft::propagate_on_copy_assignment(n_alloc_, x.n_alloc_);
+  assign(x.begin(), x.end());
+  return *this;
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc> &forward_list<T, Alloc>::operator=(forward_list &&x) {
+  if (this == &x) {
+    return *this;
+  }
+  typedef typename alloc_traits_::propagate_on_container_move_assignment
+      propagate;
+  //  nodes from an unequal allocator can't be taken over
+  if (!propagate::value && alloc_ != x.alloc_) {
+    assign(std::make_move_iterator(x.begin()),
+           std::make_move_iterator(x.end()));
+    return *this;
+  }
+  //  'x' is left with this list's head, so it takes this allocator too
+  clear();
+  std::swap(head_, x.head_);
+  memory_detail::swap_allocator(alloc_, x.alloc_, propagate());
+  memory_detail::swap_allocator(n_alloc_, x.n_alloc_, propagate());
+  return *this;
+}
+
+template<class T, class Alloc>
+forward_list<T, Alloc> &forward_list<T, Alloc>::operator=(
+    std::initializer_list<value_type> l) {
+  assign(l.begin(), l.end());
+  return *this;
+}
+
+template<class T, class Alloc>
+template<class Iter>
+void forward_list<T, Alloc>::assign(Iter first, Iter last,
+                                    typename std::enable_if
+                                        <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  forward_list copy(first, last, alloc_);
+  std::swap(head_, copy.head_);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::assign(size_type n, const value_type &t) {
+  forward_list copy(n, t, alloc_);
+  std::swap(head_, copy.head_);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::assign(std::initializer_list<value_type> l) {
+  assign(l.begin(), l.end());
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::allocator_type
+    forward_list<T, Alloc>::get_allocator() const noexcept {
+  return alloc_;
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::before_begin() noexcept {
+  return iterator(head_);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_iterator
+    forward_list<T, Alloc>::before_begin() const noexcept {
+  return const_iterator(head_);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::begin() noexcept {
+  return iterator(head_->next_);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_iterator
+    forward_list<T, Alloc>::begin() const noexcept {
+  return const_iterator(head_->next_);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::end() noexcept {
+  return iterator(nullptr);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_iterator
+    forward_list<T, Alloc>::end() const noexcept {
+  return const_iterator(nullptr);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_iterator
+    forward_list<T, Alloc>::cbefore_begin() const noexcept {
+  return before_begin();
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_iterator
+    forward_list<T, Alloc>::cbegin() const noexcept {
+  return begin();
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_iterator
+    forward_list<T, Alloc>::cend() const noexcept {
+  return end();
+}
+
+template<class T, class Alloc>
+bool forward_list<T, Alloc>::empty() const noexcept {
+  return !head_->next_;
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::size_type
+    forward_list<T, Alloc>::max_size() const noexcept {
+  return std::min<size_type>(node_traits_::max_size(n_alloc_),
+                             std::numeric_limits<difference_type>::max());
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::reference forward_list<T, Alloc>::front() {
+  return head_->next_->value_;
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::const_reference
+    forward_list<T, Alloc>::front() const {
+  return head_->next_->value_;
+}
+
+template<class T, class Alloc>
+template<class... Args>
+void forward_list<T, Alloc>::emplace_front(Args &&... args) {
+  emplace_after(cbefore_begin(), std::forward<Args>(args) ...);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::push_front(const value_type &x) {
+  emplace_after(cbefore_begin(), x);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::push_front(value_type &&x) {
+  emplace_after(cbefore_begin(), std::move(x));
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::pop_front() {
+  erase_after(cbefore_begin());
+}
+
+template<class T, class Alloc>
+template<class... Args>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::emplace_after(const_iterator position,
+                                          Args &&... args) {
+  Node_ *p = create_node_(std::forward<Args>(args) ...);
+  link_chain_after_(position.base(), p, p);
+  return iterator(p);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator position,
+                                         const value_type &x) {
+  return emplace_after(position, x);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator position,
+                                         value_type &&x) {
+  return emplace_after(position, std::move(x));
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator position,
+                                         size_type n,
+                                         const value_type &x) {
+  if (n == 0) {
+    return iterator(position);
+  }
+  Node_ *first = create_node_(x);
+  Node_ *last = first;
+  try {
+    for (size_type i = 1; i < n; ++i) {
+      last->next_ = create_node_(x);
+      last = last->next_;
+    }
+  } catch (...) {
+    while (first) {
+      Node_ *next = first->next_;
+      destroy_node_(first);
+      first = next;
+    }
+    throw;
+  }
+  link_chain_after_(position.base(), first, last);
+  return iterator(last);
+}
+
+template<class T, class Alloc>
+template<class Iter>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator position,
+                                         Iter first,
+                                         Iter last,
+                                         typename std::enable_if
+                                             <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  if (first == last) {
+    return iterator(position);
+  }
+  Node_ *n_first = create_node_(*first);
+  Node_ *n_last = n_first;
+  try {
+    for (++first; first != last; ++first) {
+      n_last->next_ = create_node_(*first);
+      n_last = n_last->next_;
+    }
+  } catch (...) {
+    while (n_first) {
+      Node_ *next = n_first->next_;
+      destroy_node_(n_first);
+      n_first = next;
+    }
+    throw;
+  }
+  link_chain_after_(position.base(), n_first, n_last);
+  return iterator(n_last);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator position,
+                                         std::initializer_list<value_type> il) {
+  return insert_after(position, il.begin(), il.end());
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::erase_after(const_iterator position) {
+  Node_ *pos = position.base();
+  Node_ *p = pos->next_;
+  pos->next_ = p->next_;
+  destroy_node_(p);
+  return iterator(pos->next_);
+}
+
+template<class T, class Alloc>
+typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::erase_after(const_iterator first,
+                                        const_iterator last) {
+  Node_ *pos = first.base();
+  Node_ *end = last.base();
+  Node_ *p = pos->next_;
+  while (p != end) {
+    Node_ *next = p->next_;
+    destroy_node_(p);
+    p = next;
+  }
+  pos->next_ = end;
+  return iterator(end);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::swap(forward_list &x) noexcept {
+  std::swap(head_, x.head_);
+  ft::propagate_on_swap(alloc_, x.alloc_);
+  ft::propagate_on_swap(n_alloc_, x.n_alloc_);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::resize(size_type sz) {
+  Node_ *p = head_;
+  for (; sz && p->next_; --sz) {
+    p = p->next_;
+  }
+  if (p->next_) {
+    erase_after(const_iterator(p), cend());
+  }
+  for (; sz; --sz) {
+    p = emplace_after(const_iterator(p)).base();
+  }
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::resize(size_type sz, const value_type &c) {
+  Node_ *p = head_;
+  for (; sz && p->next_; --sz) {
+    p = p->next_;
+  }
+  if (p->next_) {
+    erase_after(const_iterator(p), cend());
+  }
+  insert_after(const_iterator(p), sz, c);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::clear() noexcept {
+  erase_after(cbefore_begin(), cend());
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator position,
+                                          forward_list &x) {
+  if (this == std::addressof(x) || x.empty()) {
+    return;
+  }
+  Node_ *last = x.head_->next_;
+  while (last->next_) {
+    last = last->next_;
+  }
+  link_chain_after_(position.base(), x.head_->next_, last);
+  x.head_->next_ = nullptr;
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator position,
+                                          forward_list &&x) {
+  splice_after(position, x);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator position,
+                                          forward_list &,
+                                          const_iterator i) {
+  Node_ *pos = position.base();
+  Node_ *prev = i.base();
+  Node_ *p = prev->next_;
+  if (pos == prev || pos == p) {
+    return;
+  }
+  prev->next_ = p->next_;
+  link_chain_after_(pos, p, p);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator position,
+                                          forward_list &&x,
+                                          const_iterator i) {
+  splice_after(position, x, i);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator position,
+                                          forward_list &,
+                                          const_iterator first,
+                                          const_iterator last) {
+  Node_ *before = first.base();
+  Node_ *end = last.base();
+  if (before->next_ == end) {
+    return;
+  }
+  Node_ *back = before->next_;
+  while (back->next_ != end) {
+    back = back->next_;
+  }
+  Node_ *n_first = before->next_;
+  before->next_ = end;
+  link_chain_after_(position.base(), n_first, back);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::splice_after(const_iterator position,
+                                          forward_list &&x,
+                                          const_iterator first,
+                                          const_iterator last) {
+  splice_after(position, x, first, last);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::remove(const value_type &value) {
+  remove_if([&value](const value_type &x) { return x == value; });
+}
+
+template<class T, class Alloc>
+template<class Pred>
+void forward_list<T, Alloc>::remove_if(Pred pred) {
+  Node_ *p = head_;
+  while (p->next_) {
+    if (pred(p->next_->value_)) {
+      erase_after(const_iterator(p));
+    } else {
+      p = p->next_;
+    }
+  }
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::unique() {
+  unique(std::equal_to<value_type>());
+}
+
+template<class T, class Alloc>
+template<class BinaryPredicate>
+void forward_list<T, Alloc>::unique(BinaryPredicate binary_pred) {
+  Node_ *p = head_->next_;
+  if (!p) {
+    return;
+  }
+  while (p->next_) {
+    if (binary_pred(p->value_, p->next_->value_)) {
+      erase_after(const_iterator(p));
+    } else {
+      p = p->next_;
+    }
+  }
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::merge(forward_list &x) {
+  merge(x, std::less<value_type>());
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::merge(forward_list &&x) {
+  merge(x);
+}
+
+template<class T, class Alloc>
+template<class Compare>
+void forward_list<T, Alloc>::merge(forward_list &x, Compare comp) {
+  if (this == std::addressof(x)) {
+    return;
+  }
+  head_->next_ = merge_chains_(head_->next_, x.head_->next_, comp);
+  x.head_->next_ = nullptr;
+}
+
+template<class T, class Alloc>
+template<class Compare>
+void forward_list<T, Alloc>::merge(forward_list &&x, Compare comp) {
+  merge(x, comp);
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::sort() {
+  sort(std::less<value_type>());
+}
+
+//  merge sort on the node chain: sorted runs of 2^i nodes are kept in bins
+//  and merged as the input is consumed, so recently touched nodes are merged
+//  together and no memory is allocated
+template<class T, class Alloc>
+template<class Compare>
+void forward_list<T, Alloc>::sort(Compare comp) {
+  Node_ *p = head_->next_;
+  if (!p || !p->next_) {
+    return;
+  }
+  Node_ *bins[64] = {};
+  size_type fill = 0;
+  while (p) {
+    Node_ *carry = p;
+    p = p->next_;
+    carry->next_ = nullptr;
+    size_type i = 0;
+    for (; i < fill && bins[i]; ++i) {
+      carry = merge_chains_(bins[i], carry, comp);
+      bins[i] = nullptr;
+    }
+    bins[i] = carry;
+    if (i == fill) {
+      ++fill;
+    }
+  }
+  Node_ *result = nullptr;
+  for (size_type i = 0; i < fill; ++i) {
+    result = merge_chains_(bins[i], result, comp);
+  }
+  head_->next_ = result;
+}
+
+template<class T, class Alloc>
+void forward_list<T, Alloc>::reverse() noexcept {
+  Node_ *p = head_->next_;
+  Node_ *reversed = nullptr;
+  while (p) {
+    Node_ *next = p->next_;
+    p->next_ = reversed;
+    reversed = p;
+    p = next;
+  }
+  head_->next_ = reversed;
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator==(const forward_list<T, Alloc> &x, const forward_list<T, Alloc> &y) {
+  auto i = x.begin();
+  auto j = y.begin();
+  for (; i != x.end() && j != y.end(); ++i, ++j) {
+    if (!(*i == *j)) {
+      return false;
+    }
+  }
+  return i == x.end() && j == y.end();
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator<(const forward_list<T, Alloc> &x, const forward_list<T, Alloc> &y) {
+  return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator!=(const forward_list<T, Alloc> &x, const forward_list<T, Alloc> &y) {
+  return !(x == y);
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator>(const forward_list<T, Alloc> &x, const forward_list<T, Alloc> &y) {
+  return y < x;
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator>=(const forward_list<T, Alloc> &x, const forward_list<T, Alloc> &y) {
+  return !(x < y);
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator<=(const forward_list<T, Alloc> &x, const forward_list<T, Alloc> &y) {
+  return !(y < x);
+}
+
+template<class T, class Alloc>
+inline
+void
+swap(forward_list<T, Alloc> &x,
+     forward_list<T, Alloc> &y) noexcept(noexcept(x.swap(y))) {
+  x.swap(y);
+}
+
+namespace pmr {
+
+template<class T>
+using forward_list = ft::forward_list<T, ft::pmr::polymorphic_allocator<T> >;
+
+}
+
+}
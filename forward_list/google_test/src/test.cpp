@@ -0,0 +1,259 @@
+// -*- C++ -*-
+//===------------------------ forward list test ---------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#include <forward_list>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+//Your include
+#include "forward_list/forward_list.h"
+
+// Your namespace
+#define my ft
+#define forward_list_ forward_list
+// STD namespace
+#define stl std
+#define _forward_list forward_list
+
+template<class T, class Alloc>
+void compare_lst(my::forward_list_<T, Alloc> &my_lst,
+                 stl::_forward_list<T> &stl_lst) {
+  EXPECT_EQ(std::distance(my_lst.begin(), my_lst.end()),
+            std::distance(stl_lst.begin(), stl_lst.end()))
+            << "\nLists x and y are of unequal length\n";
+  auto my_iter = my_lst.cbegin();
+  auto stl_iter = stl_lst.cbegin();
+  for (; my_iter != my_lst.cend() && stl_iter != stl_lst.cend();
+         ++my_iter, ++stl_iter) {
+    EXPECT_EQ(*my_iter, *stl_iter)
+              << "list x and y differ";
+  }
+}
+
+template<class T>
+void init_lst(my::forward_list_<T> &my_lst, stl::_forward_list<T> &stl_lst) {
+  std::random_device rd;
+  std::default_random_engine eng(rd());
+  std::uniform_int_distribution<T> eng_rand(-10000, 10000);
+  auto my_iter = my_lst.begin();
+  auto stl_iter = stl_lst.begin();
+  for (; my_iter != my_lst.end() && stl_iter != stl_lst.end();
+         ++my_iter, ++stl_iter) {
+    *my_iter = *stl_iter = eng_rand(eng);
+  }
+}
+
+// =============================================================================
+// ============================= Constructor ===================================
+// =============================================================================
+
+TEST(forward_list, default_constructor) {
+  my::forward_list_<int> my_lst;
+  stl::_forward_list<int> stl_lst;
+  EXPECT_TRUE(my_lst.empty());
+  compare_lst(my_lst, stl_lst);
+}
+
+TEST(forward_list, value_constructor) {
+  my::forward_list_<std::string> my_lst(12, "234");
+  stl::_forward_list<std::string> stl_lst(12, "234");
+  compare_lst(my_lst, stl_lst);
+  my::forward_list_<int> my_default(7);
+  stl::_forward_list<int> stl_default(7);
+  compare_lst(my_default, stl_default);
+}
+
+TEST(forward_list, copy_and_move_constructor) {
+  my::forward_list_<int> my_tmp(40);
+  stl::_forward_list<int> stl_tmp(40);
+  init_lst(my_tmp, stl_tmp);
+  my::forward_list_<int> my_copy(my_tmp);
+  compare_lst(my_copy, stl_tmp);
+  my::forward_list_<int> my_move(std::move(my_tmp));
+  compare_lst(my_move, stl_tmp);
+  EXPECT_TRUE(my_tmp.empty());
+}
+
+TEST(forward_list, initializer_list_constructor) {
+  my::forward_list_<std::string> my_lst = {"2 ", "3", "3"};
+  stl::_forward_list<std::string> stl_lst = {"2 ", "3", "3"};
+  compare_lst(my_lst, stl_lst);
+}
+
+// =============================================================================
+// =========================== Member Function =================================
+// =============================================================================
+
+// =========================== INSERT_AFTER ====================================
+
+TEST(forward_list, insert_after) {
+  my::forward_list_<int> my_lst = {1, 2, 3};
+  stl::_forward_list<int> stl_lst = {1, 2, 3};
+  auto my_iter = my_lst.insert_after(my_lst.begin(), 10);
+  auto stl_iter = stl_lst.insert_after(stl_lst.begin(), 10);
+  EXPECT_EQ(*my_iter, *stl_iter);
+  my_iter = my_lst.insert_after(my_iter, 3, 7);
+  stl_iter = stl_lst.insert_after(stl_iter, 3, 7);
+  EXPECT_EQ(*++my_iter, *++stl_iter);
+  std::vector<int> v = {4, 5, 6};
+  my_lst.insert_after(my_lst.before_begin(), v.begin(), v.end());
+  stl_lst.insert_after(stl_lst.before_begin(), v.begin(), v.end());
+  my_lst.push_front(-1);
+  stl_lst.push_front(-1);
+  compare_lst(my_lst, stl_lst);
+}
+
+// ============================ ERASE_AFTER ====================================
+
+TEST(forward_list, erase_after) {
+  my::forward_list_<int> my_lst = {1, 2, 3, 4, 5, 6, 7};
+  stl::_forward_list<int> stl_lst = {1, 2, 3, 4, 5, 6, 7};
+  my_lst.erase_after(my_lst.begin());
+  stl_lst.erase_after(stl_lst.begin());
+  compare_lst(my_lst, stl_lst);
+  my_lst.erase_after(my_lst.begin(), std::next(my_lst.begin(), 3));
+  stl_lst.erase_after(stl_lst.begin(), std::next(stl_lst.begin(), 3));
+  compare_lst(my_lst, stl_lst);
+  my_lst.pop_front();
+  stl_lst.pop_front();
+  compare_lst(my_lst, stl_lst);
+  my_lst.resize(6, 9);
+  stl_lst.resize(6, 9);
+  compare_lst(my_lst, stl_lst);
+  my_lst.resize(2);
+  stl_lst.resize(2);
+  compare_lst(my_lst, stl_lst);
+}
+
+// ============================ SPLICE_AFTER ===================================
+
+TEST(forward_list, splice_after) {
+  my::forward_list_<int> my_lst = {1, 2, 3};
+  my::forward_list_<int> my_other = {10, 11, 12, 13};
+  stl::_forward_list<int> stl_lst = {1, 2, 3};
+  stl::_forward_list<int> stl_other = {10, 11, 12, 13};
+  my_lst.splice_after(my_lst.begin(), my_other, my_other.begin());
+  stl_lst.splice_after(stl_lst.begin(), stl_other, stl_other.begin());
+  compare_lst(my_lst, stl_lst);
+  compare_lst(my_other, stl_other);
+  my_lst.splice_after(my_lst.before_begin(), my_other,
+                      my_other.before_begin(), std::next(my_other.begin(), 2));
+  stl_lst.splice_after(stl_lst.before_begin(), stl_other,
+                       stl_other.before_begin(),
+                       std::next(stl_other.begin(), 2));
+  compare_lst(my_lst, stl_lst);
+  compare_lst(my_other, stl_other);
+  my_lst.splice_after(my_lst.begin(), my_other);
+  stl_lst.splice_after(stl_lst.begin(), stl_other);
+  compare_lst(my_lst, stl_lst);
+  compare_lst(my_other, stl_other);
+}
+
+// ============================ SORT / MERGE ===================================
+
+TEST(forward_list, sort) {
+  my::forward_list_<int> my_lst(1000);
+  stl::_forward_list<int> stl_lst(1000);
+  init_lst(my_lst, stl_lst);
+  my_lst.sort();
+  stl_lst.sort();
+  compare_lst(my_lst, stl_lst);
+  my_lst.sort(std::greater<int>());
+  stl_lst.sort(std::greater<int>());
+  compare_lst(my_lst, stl_lst);
+}
+
+TEST(forward_list, merge) {
+  my::forward_list_<int> my_lst = {1, 4, 4, 9};
+  my::forward_list_<int> my_other = {0, 4, 5, 10, 11};
+  stl::_forward_list<int> stl_lst = {1, 4, 4, 9};
+  stl::_forward_list<int> stl_other = {0, 4, 5, 10, 11};
+  my_lst.merge(my_other);
+  stl_lst.merge(stl_other);
+  compare_lst(my_lst, stl_lst);
+  EXPECT_TRUE(my_other.empty());
+}
+
+TEST(forward_list, remove_unique_reverse) {
+  my::forward_list_<int> my_lst = {1, 1, 2, 3, 3, 3, 4, 1, 5};
+  stl::_forward_list<int> stl_lst = {1, 1, 2, 3, 3, 3, 4, 1, 5};
+  my_lst.unique();
+  stl_lst.unique();
+  compare_lst(my_lst, stl_lst);
+  my_lst.remove(1);
+  stl_lst.remove(1);
+  compare_lst(my_lst, stl_lst);
+  my_lst.reverse();
+  stl_lst.reverse();
+  compare_lst(my_lst, stl_lst);
+}
+
+// Nodes come from the pool once the allocator is rebound to the node type.
+TEST(forward_list, pool_allocator) {
+  my::forward_list_<std::string, ft::PoolAllocator<std::string> > my_lst;
+  stl::_forward_list<std::string> stl_lst;
+  for (int i = 0; i < 500; ++i) {
+    my_lst.push_front(std::to_string(i));
+    stl_lst.push_front(std::to_string(i));
+  }
+  my_lst.sort();
+  stl_lst.sort();
+  compare_lst(my_lst, stl_lst);
+  my_lst.clear();
+  EXPECT_TRUE(my_lst.empty());
+}
+
+// The free slots of a thread that exits are taken over by the next thread.
+TEST(forward_list, pool_allocator_thread_exit) {
+  struct slot { long value[3]; };
+  ft::PoolAllocator<slot> pool;
+  slot *first = nullptr;
+  slot *second = nullptr;
+  std::thread([&]() {
+    first = pool.allocate(1);
+    pool.deallocate(first, 1);
+  }).join();
+  std::thread([&]() {
+    second = pool.allocate(1);
+    pool.deallocate(second, 1);
+  }).join();
+  EXPECT_EQ(first, second);
+  my::forward_list_<int, ft::PoolAllocator<int> > my_lst;
+  std::thread([&]() {
+    my::forward_list_<int, ft::PoolAllocator<int> > lst(1000, 7);
+  }).join();
+  my_lst.assign(1000, 7);
+  EXPECT_EQ(std::distance(my_lst.begin(), my_lst.end()), 1000);
+}
+
+// A pmr list takes its nodes from the resource, and a move between lists
+// on different resources moves the elements instead of the nodes.
+TEST(forward_list, pmr) {
+  char buffer[4096];
+  ft::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+  ft::pmr::forward_list<int> my_lst({1, 2, 3}, &arena);
+  EXPECT_EQ(my_lst.get_allocator().resource(), &arena);
+  ft::pmr::forward_list<int> copy(my_lst);
+  EXPECT_EQ(copy.get_allocator().resource(), ft::pmr::get_default_resource());
+  EXPECT_TRUE(copy == my_lst);
+  ft::pmr::forward_list<int> moved(std::move(my_lst));
+  EXPECT_EQ(moved.get_allocator().resource(), &arena);
+  copy = std::move(moved);
+  EXPECT_EQ(copy.get_allocator().resource(), ft::pmr::get_default_resource());
+  EXPECT_EQ(*std::next(copy.begin(), 2), 3);
+  ft::pmr::forward_list<int> other(&arena);
+  other.swap(moved);
+  EXPECT_EQ(other.front(), 1);
+  ft::pmr::forward_list<ft::pmr::forward_list<int> > nested(&arena);
+  nested.emplace_front(2, 5);
+  EXPECT_EQ(nested.front().get_allocator().resource(), &arena);
+  EXPECT_EQ(nested.front().front(), 5);
+}
+
+// =============================================================================
+// =============================== FINISH ======================================
+// =============================================================================
@@ -24,6 +24,8 @@ class bidirectional_iterator {
                                                        Node> const &other);
   inline bidirectional_iterator(bidirectional_iterator<const value_type,
                                                        Node> const &other);
+  inline bidirectional_iterator &operator=(bidirectional_iterator const &other)
+  = default;
   inline reference operator*();
   inline pointer operator->();
   inline bidirectional_iterator operator++();
@@ -6,10 +6,16 @@
 //===----------------------------------------------------------------------===//
 
 #include <list>
+#include <memory_resource>
 #include <random>
+#include <thread>
 #include "gtest/gtest.h"
 //Your include
 #include "list/list.h"
+#include "list/unrolled_list.h"
+#include "list/index_list.h"
+#include "tools/parallel_sort.h"
+#include "tools/profile.h"
 
 // Your namespace
 #define my ft
@@ -18,8 +24,8 @@
 #define stl std
 #define _list list
 
-template<class T>
-void compare_lst(my::list_<T> &my_lst, stl::_list<T> &stl_lst) {
+template<class T, class Alloc>
+void compare_lst(my::list_<T, Alloc> &my_lst, stl::_list<T> &stl_lst) {
   EXPECT_EQ(my_lst.size(), stl_lst.size())
             << "\nVectors x and y are of unequal length\n";
   auto my_iter = my_lst.cbegin();
@@ -261,6 +267,32 @@ TEST(list, assign_range) {
   assign_range();
 }
 
+// Assignment reuses the existing nodes and frees only the tail.
+TEST(list, assign_reuses_nodes) {
+  my::list_<std::string> my_lst(100, "a");
+  std::vector<my::list_<std::string>::iterator> nodes;
+  for (auto i = my_lst.begin(); i != my_lst.end(); ++i) {
+    nodes.push_back(i);
+  }
+  std::vector<std::string> v(60, "b");
+  my_lst.assign(v.begin(), v.end());
+  EXPECT_EQ(my_lst.size(), 60u);
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), my_lst.begin()));
+  EXPECT_EQ(my_lst.begin().base(), nodes[0].base());
+  EXPECT_EQ(std::prev(my_lst.end()).base(), nodes[59].base());
+  my_lst.assign(80, "c");
+  EXPECT_EQ(my_lst.size(), 80u);
+  EXPECT_EQ(std::next(my_lst.begin(), 59).base(), nodes[59].base());
+  EXPECT_EQ(my_lst.back(), "c");
+  my::list_<std::string> my_other(10, "d");
+  my_lst = my_other;
+  EXPECT_EQ(my_lst, my_other);
+  EXPECT_EQ(my_lst.begin().base(), nodes[0].base());
+  my_lst = {"e", "f"};
+  EXPECT_EQ(my_lst.size(), 2u);
+  EXPECT_EQ(my_lst.back(), "f");
+}
+
 // =============================== BACK ========================================
 
 // Returns a read/write reference to the data at the last element of the list.
@@ -297,6 +329,865 @@ TEST(list, back) {
 
 
 
+// =============================== SPLICE ======================================
+
+// Range splices with a known count or a lazy size keep size() right.
+TEST(list, splice_range_size) {
+  my::list_<int> my_lst(100, 1);
+  my::list_<int> my_other(50, 2);
+  my_lst.splice(my_lst.begin(), my_other, std::next(my_other.begin(), 10),
+                std::next(my_other.begin(), 30), 20);
+  EXPECT_EQ(my_lst.size(), 120u);
+  EXPECT_EQ(my_other.size(), 30u);
+  EXPECT_EQ(my_lst.front(), 2);
+  my::list_<int, my::Allocator<int>, my::list_lazy_size> my_lazy(100, 1);
+  my::list_<int, my::Allocator<int>, my::list_lazy_size> my_lazy_other(50, 2);
+  my_lazy.splice(my_lazy.end(), my_lazy_other, my_lazy_other.begin(),
+                 std::next(my_lazy_other.begin(), 40));
+  my_lazy.push_back(3);
+  my_lazy_other.pop_front();
+  EXPECT_EQ(my_lazy.size(), 141u);
+  EXPECT_EQ(my_lazy_other.size(), 9u);
+  EXPECT_EQ(my_lazy.back(), 3);
+  my_lazy_other.splice(my_lazy_other.begin(), my_lazy);
+  EXPECT_TRUE(my_lazy.empty());
+  EXPECT_EQ(my_lazy_other.size(), 150u);
+}
+
+// =============================== MERGE =======================================
+
+// Merging keeps equal elements of *this first and moves every element of x.
+TEST(list, merge) {
+  for (int offset = 0; offset <= 120; offset += 20) {
+    my::list_<int> my_lst;
+    my::list_<int> my_other;
+    stl::_list<int> stl_lst;
+    stl::_list<int> stl_other;
+    for (int i = 0; i < 100; ++i) {
+      my_lst.push_back(i);
+      stl_lst.push_back(i);
+      my_other.push_back(i / 2 + offset);
+      stl_other.push_back(i / 2 + offset);
+    }
+    my_lst.merge(my_other);
+    stl_lst.merge(stl_other);
+    compare_lst(my_lst, stl_lst);
+    EXPECT_TRUE(my_other.empty());
+    EXPECT_EQ(my_other.size(), 0u);
+  }
+  my::list_<std::pair<int, int> > my_lst = {{1, 0}, {2, 0}, {2, 1}, {5, 0}};
+  my::list_<std::pair<int, int> > my_other = {{0, 2}, {2, 2}, {5, 2}};
+  my_lst.merge(my_other, [](const std::pair<int, int> &a,
+                            const std::pair<int, int> &b) {
+    return a.first < b.first;
+  });
+  std::vector<std::pair<int, int> > expected = {{0, 2}, {1, 0}, {2, 0}, {2, 1},
+                                                {2, 2}, {5, 0}, {5, 2}};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), my_lst.begin()));
+}
+
+// ================================ SORT =======================================
+
+// Both sort paths are stable, and a throwing comparator loses no element.
+TEST(list, sort) {
+  auto by_first = [](const std::pair<int, int> &a,
+                     const std::pair<int, int> &b) {
+    return a.first < b.first;
+  };
+  for (int size : {0, 1, 5, 7, 8, 1000}) {
+    my::list_<std::pair<int, int> > my_lst;
+    stl::_list<std::pair<int, int> > stl_lst;
+    for (int i = 0; i < size; ++i) {
+      my_lst.push_back(std::make_pair(i * 7 % 5, i));
+      stl_lst.push_back(my_lst.back());
+    }
+    my::list_<std::pair<int, int> > my_keyed(my_lst);
+    my_lst.sort(by_first);
+    stl_lst.sort(by_first);
+    compare_lst(my_lst, stl_lst);
+    my_keyed.sort_by_key([](const std::pair<int, int> &x) { return x.first; });
+    compare_lst(my_keyed, stl_lst);
+  }
+  for (int size : {7, 1000}) {
+    my::list_<int> my_lst;
+    for (int i = 0; i < size; ++i) {
+      my_lst.push_front(i);
+    }
+    int calls = 0;
+    EXPECT_THROW(my_lst.sort([&calls](int a, int b) {
+      if (++calls == 10) {
+        throw std::runtime_error("compare");
+      }
+      return a < b;
+    }), std::runtime_error);
+    EXPECT_EQ(my_lst.size(), static_cast<size_t>(size));
+    EXPECT_EQ(std::distance(my_lst.begin(), my_lst.end()), size);
+  }
+}
+
+// ============================ BULK INSERT ====================================
+
+struct throw_on_copy {
+  static int countdown;
+  int value;
+  throw_on_copy() : value(0) {}
+  throw_on_copy(const throw_on_copy &x) : value(x.value) {
+    if (countdown-- == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  throw_on_copy &operator=(const throw_on_copy &x) = default;
+};
+int throw_on_copy::countdown = -1;
+
+// Fill and range inserts take their nodes from blocks and stay all or nothing.
+TEST(list, bulk_insert) {
+  my::list_<int> my_lst(1000, 7);
+  stl::_list<int> stl_lst(1000, 7);
+  auto my_iter = my_lst.begin();
+  for (int i = 0; i < 10; ++i, ++my_iter) {
+    EXPECT_EQ(std::next(my_iter).base(), my_iter.base() + 1);
+  }
+  std::vector<int> v = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  my_iter = my_lst.insert(std::next(my_lst.begin(), 3), v.begin(), v.end());
+  auto stl_iter = stl_lst.insert(std::next(stl_lst.begin(), 3),
+                                 v.begin(), v.end());
+  EXPECT_EQ(*my_iter, *stl_iter);
+  my_lst.resize(2000);
+  stl_lst.resize(2000);
+  my_lst.resize(500, 3);
+  stl_lst.resize(500, 3);
+  compare_lst(my_lst, stl_lst);
+  my::list_<throw_on_copy> my_throw(10);
+  throw_on_copy::countdown = 20;
+  EXPECT_THROW(my_throw.insert(my_throw.begin(), 30, throw_on_copy()),
+               std::runtime_error);
+  throw_on_copy::countdown = -1;
+  EXPECT_EQ(my_throw.size(), 10u);
+  EXPECT_EQ(std::distance(my_throw.begin(), my_throw.end()), 10);
+}
+
+// =============================== COMPACT =====================================
+
+// Relinks the nodes into blocks in list order without changing the elements.
+TEST(list, compact) {
+  my::list_<std::string> my_lst;
+  stl::_list<std::string> stl_lst;
+  for (int i = 0; i < 1000; ++i) {
+    my_lst.push_back(std::to_string(i));
+    stl_lst.push_back(std::to_string(i));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    int from = i * 7 % 1000;
+    my_lst.splice(my_lst.begin(), my_lst, std::next(my_lst.begin(), from));
+    stl_lst.splice(stl_lst.begin(), stl_lst, std::next(stl_lst.begin(), from));
+  }
+  my_lst.erase(std::next(my_lst.begin(), 100), std::next(my_lst.begin(), 200));
+  stl_lst.erase(std::next(stl_lst.begin(), 100),
+                std::next(stl_lst.begin(), 200));
+  my_lst.compact();
+  compare_lst(my_lst, stl_lst);
+  auto my_iter = my_lst.begin();
+  for (int i = 0; i < 10; ++i, ++my_iter) {
+    EXPECT_EQ(std::next(my_iter).base(), my_iter.base() + 1);
+  }
+  my_lst.pop_front();
+  stl_lst.pop_front();
+  my_lst.push_back("x");
+  stl_lst.push_back("x");
+  compare_lst(my_lst, stl_lst);
+  {
+    my::list_<std::string> my_other;
+    stl::_list<std::string> stl_other;
+    my_other.splice(my_other.end(), my_lst, std::next(my_lst.begin(), 10),
+                    std::next(my_lst.begin(), 20));
+    stl_other.splice(stl_other.end(), stl_lst, std::next(stl_lst.begin(), 10),
+                     std::next(stl_lst.begin(), 20));
+    compare_lst(my_other, stl_other);
+  }
+  my_lst.compact();
+  compare_lst(my_lst, stl_lst);
+  my::list_<std::string> my_short(5, "short");
+  auto my_first = my_short.begin().base();
+  my_short.compact();
+  EXPECT_EQ(my_short.begin().base(), my_first);
+}
+
+// Lists that swapped nodes out of blocks free them whichever goes first, and
+// lists on other threads keep blocks of their own.
+TEST(list, shared_blocks) {
+  typedef ft::CountingAllocator<int, ft::Allocator<int> > alloc;
+  ft::AllocationStats blocks("shared blocks");
+  const alloc counted(&blocks);
+  {
+    my::list_<int, alloc> my_lst(100, 1, counted);
+    stl::_list<int> stl_lst(100, 1);
+    {
+      my::list_<int, alloc> my_other(100, 2, counted);
+      stl::_list<int> stl_other(100, 2);
+      my::list_<int, alloc> my_third(50, 3, counted);
+      stl::_list<int> stl_third(50, 3);
+      my_lst.splice(my_lst.begin(), my_other, std::next(my_other.begin(), 10),
+                    std::next(my_other.begin(), 30));
+      stl_lst.splice(stl_lst.begin(), stl_other,
+                     std::next(stl_other.begin(), 10),
+                     std::next(stl_other.begin(), 30));
+      my_third.splice(my_third.end(), my_lst, my_lst.begin());
+      stl_third.splice(stl_third.end(), stl_lst, stl_lst.begin());
+      my_other.splice(my_other.end(), my_third);
+      stl_other.splice(stl_other.end(), stl_third);
+      my_lst.erase(std::next(my_lst.begin(), 5), std::next(my_lst.begin(), 95));
+      stl_lst.erase(std::next(stl_lst.begin(), 5),
+                    std::next(stl_lst.begin(), 95));
+      compare_lst(my_other, stl_other);
+    }
+    compare_lst(my_lst, stl_lst);
+    my_lst.compact();
+    compare_lst(my_lst, stl_lst);
+  }
+  EXPECT_EQ(blocks.live_bytes(), 0u);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([t]() {
+      for (int round = 0; round < 20; ++round) {
+        my::list_<int> my_lst(200, t);
+        my::list_<int> my_other(100, t);
+        my_lst.splice(my_lst.end(), my_other, my_other.begin(),
+                      std::next(my_other.begin(), 50));
+        my_lst.erase(my_lst.begin(), std::next(my_lst.begin(), 150));
+        my_lst.compact();
+        EXPECT_EQ(my_lst.size(), 100u);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// ============================ PARALLEL SORT ==================================
+
+// Sorts like list::sort and std::sort whatever the requested thread count.
+TEST(list, parallel_sort) {
+  std::mt19937 random(7);
+  for (size_t threads = 1; threads <= 5; ++threads) {
+    my::list_<std::pair<int, int> > my_lst;
+    stl::_list<std::pair<int, int> > stl_lst;
+    ft::vector<int> my_vec;
+    std::vector<int> stl_vec;
+    for (int i = 0; i < 50000; ++i) {
+      std::pair<int, int> value(static_cast<int>(random() % 100), i);
+      my_lst.push_back(value);
+      stl_lst.push_back(value);
+      my_vec.push_back(static_cast<int>(random()));
+      stl_vec.push_back(my_vec.back());
+    }
+    auto by_first = [](const std::pair<int, int> &a,
+                       const std::pair<int, int> &b) {
+      return a.first < b.first;
+    };
+    ft::parallel_sort(my_lst, by_first, threads);
+    stl_lst.sort(by_first);
+    compare_lst(my_lst, stl_lst);
+    ft::parallel_sort(my_vec, threads);
+    std::sort(stl_vec.begin(), stl_vec.end());
+    EXPECT_TRUE(std::equal(stl_vec.begin(), stl_vec.end(), my_vec.data()));
+  }
+  // move-only elements are sampled through pointers, never copied
+  ft::vector<std::unique_ptr<int> > my_ptrs;
+  std::vector<int> stl_ints;
+  for (int i = 0; i < 50000; ++i) {
+    my_ptrs.push_back(
+        std::unique_ptr<int>(new int(static_cast<int>(random()))));
+    stl_ints.push_back(*my_ptrs.back());
+  }
+  ft::parallel_sort(my_ptrs, [](const std::unique_ptr<int> &a,
+                                const std::unique_ptr<int> &b) {
+    return *a < *b;
+  }, 4);
+  std::sort(stl_ints.begin(), stl_ints.end());
+  for (size_t i = 0; i < stl_ints.size(); ++i) {
+    ASSERT_EQ(*my_ptrs[i], stl_ints[i]);
+  }
+}
+
+// ======================== THREAD CACHE ALLOCATOR =============================
+
+// Lists built on one thread and destroyed on another keep their contents.
+TEST(list, thread_cache_allocator) {
+  typedef my::list_<int, ft::ThreadCacheAllocator<int> > cached_list;
+  const int kThreads = 4;
+  const int kLists = 200;
+  std::vector<cached_list> built(kThreads * kLists);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&built, t]() {
+      for (int i = 0; i < kLists; ++i) {
+        cached_list &lst = built[t * kLists + i];
+        for (int k = 0; k < 100 + i; ++k) {
+          lst.push_back(t * 100000 + k);
+        }
+        lst.erase(lst.begin());
+        ft::vector<int, ft::ThreadCacheAllocator<int> > buffer(i % 50, t);
+        lst.insert(lst.end(), buffer.begin(), buffer.end());
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&built, t]() {
+      int owner = (t + 1) % kThreads;
+      for (int i = 0; i < kLists; ++i) {
+        cached_list &lst = built[owner * kLists + i];
+        EXPECT_EQ(lst.size(), static_cast<size_t>(99 + i + i % 50));
+        EXPECT_EQ(lst.front(), owner * 100000 + 1);
+        lst.clear();
+        lst.push_back(i);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < kThreads * kLists; ++i) {
+    EXPECT_EQ(built[i].size(), 1u);
+    EXPECT_EQ(built[i].front(), i % kLists);
+  }
+  struct alignas(64) line { char bytes[64]; };
+  ft::vector<line, ft::ThreadCacheAllocator<line> > lines(3);
+  for (int i = 0; i < 10; ++i) {
+    lines.push_back(line());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(lines.data()) % 64, 0u);
+  }
+}
+
+// ======================== POLYMORPHIC ALLOCATOR ==============================
+
+// Nodes, the head among them, come from the list's resource and go back to it.
+TEST(list, polymorphic_allocator) {
+  ft::pmr::unsynchronized_pool_resource pool;
+  {
+    ft::pmr::monotonic_buffer_resource arena(&pool);
+    my::pmr::list<int> my_lst(&arena);
+    stl::_list<int> stl_lst;
+    for (int i = 0; i < 1000; ++i) {
+      my_lst.push_back(i);
+      stl_lst.push_back(i);
+    }
+    my_lst.remove_if([](int x) { return x % 3 == 0; });
+    stl_lst.remove_if([](int x) { return x % 3 == 0; });
+    my_lst.sort(std::greater<int>());
+    stl_lst.sort(std::greater<int>());
+    EXPECT_TRUE(std::equal(my_lst.begin(), my_lst.end(),
+                           stl_lst.begin(), stl_lst.end()));
+    my::pmr::list<int> copy(my_lst);
+    EXPECT_EQ(copy.get_allocator().resource(),
+              ft::pmr::get_default_resource());
+    my::pmr::list<int> other(&pool);
+    other = std::move(copy);
+    EXPECT_EQ(other.get_allocator().resource(), &pool);
+    EXPECT_EQ(other.size(), my_lst.size());
+    my::pmr::list<int> moved(std::move(my_lst), &arena);
+    EXPECT_TRUE(my_lst.empty());
+    EXPECT_EQ(moved.front(), 998);
+  }
+  {
+    std::pmr::unsynchronized_pool_resource std_pool;
+    my::list_<std::string, std::pmr::polymorphic_allocator<std::string> >
+        my_lst(&std_pool);
+    for (int i = 0; i < 100; ++i) {
+      my_lst.push_front(std::to_string(i));
+    }
+    my_lst.resize(50);
+    EXPECT_EQ(my_lst.size(), 50u);
+    EXPECT_EQ(my_lst.back(), "50");
+    EXPECT_EQ(my_lst.get_allocator().resource(), &std_pool);
+  }
+}
+
+// Only what allocator_traits can't fill in.  Allocators that share a counter
+// compare equal; the counter holds the nodes they have out.
+template<class T, class Propagate = std::true_type>
+struct minimal_allocator {
+  typedef T value_type;
+  typedef Propagate propagate_on_container_copy_assignment;
+  typedef Propagate propagate_on_container_move_assignment;
+  typedef Propagate propagate_on_container_swap;
+
+  explicit minimal_allocator(long *live) : live_(live) {}
+  template<class U>
+  minimal_allocator(const minimal_allocator<U, Propagate> &other)
+      : live_(other.live_) {}
+  T *allocate(size_t n) {
+    *live_ += n;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) {
+    *live_ -= n;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  long *live_;
+};
+
+template<class T, class U, class P>
+bool operator==(const minimal_allocator<T, P> &a,
+                const minimal_allocator<U, P> &b) {
+  return a.live_ == b.live_;
+}
+
+template<class T, class U, class P>
+bool operator!=(const minimal_allocator<T, P> &a,
+                const minimal_allocator<U, P> &b) {
+  return !(a == b);
+}
+
+TEST(list, allocator_propagation) {
+  long live_1 = 0;
+  long live_2 = 0;
+  {
+    typedef minimal_allocator<int> alloc;
+    const alloc alloc_1(&live_1);
+    const alloc alloc_2(&live_2);
+    my::list_<int, alloc> my_lst_1(alloc_1);
+    my::list_<int, alloc> my_lst_2(5, alloc_2);
+    for (int i = 0; i < 20; ++i) {
+      my_lst_1.push_back(i);
+    }
+    my_lst_2 = my_lst_1;
+    EXPECT_EQ(my_lst_2.get_allocator(), alloc_1);
+    EXPECT_EQ(live_2, 0);
+    EXPECT_EQ(my_lst_2, my_lst_1);
+    my::list_<int, alloc> my_lst_3(3, alloc_2);
+    my_lst_3 = std::move(my_lst_2);
+    EXPECT_EQ(my_lst_3.get_allocator(), alloc_1);
+    EXPECT_EQ(my_lst_3.size(), 20u);
+    my_lst_2.push_back(1);
+    my::list_<int, alloc> my_lst_4(2, alloc_2);
+    my_lst_4.swap(my_lst_3);
+    EXPECT_EQ(my_lst_4.get_allocator(), alloc_1);
+    EXPECT_EQ(my_lst_3.get_allocator(), alloc_2);
+    EXPECT_EQ(my_lst_3.size(), 2u);
+  }
+  EXPECT_EQ(live_1, 0);
+  EXPECT_EQ(live_2, 0);
+  {
+    typedef minimal_allocator<int, std::false_type> alloc;
+    const alloc alloc_1(&live_1);
+    const alloc alloc_2(&live_2);
+    my::list_<int, alloc> my_lst_1(10, alloc_1);
+    my::list_<int, alloc> my_lst_2(alloc_2);
+    my_lst_2 = my_lst_1;
+    EXPECT_EQ(my_lst_2.get_allocator(), alloc_2);
+    EXPECT_EQ(live_2, 11);
+    my_lst_1.push_back(7);
+    my_lst_2 = std::move(my_lst_1);
+    EXPECT_EQ(my_lst_2.get_allocator(), alloc_2);
+    EXPECT_EQ(my_lst_2.size(), 11u);
+    EXPECT_EQ(my_lst_2.back(), 7);
+    EXPECT_EQ(live_2, 12);
+  }
+  EXPECT_EQ(live_1, 0);
+  EXPECT_EQ(live_2, 0);
+  // parallel_sort takes its scratch buffer from the vector's allocator
+  {
+    const minimal_allocator<int> alloc(&live_1);
+    ft::vector<int, minimal_allocator<int> > my_vec(alloc);
+    std::vector<int> stl_vec;
+    std::mt19937 random(11);
+    for (int i = 0; i < 50000; ++i) {
+      my_vec.push_back(static_cast<int>(random()));
+      stl_vec.push_back(my_vec.back());
+    }
+    ft::parallel_sort(my_vec, 4);
+    std::sort(stl_vec.begin(), stl_vec.end());
+    EXPECT_TRUE(std::equal(stl_vec.begin(), stl_vec.end(), my_vec.data()));
+  }
+  EXPECT_EQ(live_1, 0);
+}
+
+// ========================= COUNTING ALLOCATOR ================================
+
+// Nodes are rebound from the list's allocator and still count for its tag.
+struct counted_list_tag {};
+
+TEST(list, counting_allocator) {
+  typedef ft::CountingAllocator<int, ft::Allocator<int>, counted_list_tag>
+      alloc;
+  ft::AllocationStats &shared = ft::allocation_stats<counted_list_tag>();
+  shared.reset();
+  {
+    my::list_<int, alloc> my_lst;
+    for (int i = 0; i < 10; ++i) {
+      my_lst.push_back(i);
+    }
+    EXPECT_GE(shared.allocations(), 10u);
+    EXPECT_GT(shared.live_bytes(), 10 * sizeof(int));
+    my::list_<int, alloc> my_lst_2(my_lst);
+    my_lst_2.swap(my_lst);
+    EXPECT_EQ(my_lst_2.size(), 10u);
+  }
+  EXPECT_EQ(shared.live_bytes(), 0u);
+  EXPECT_EQ(shared.allocations(), shared.deallocations());
+  ft::AllocationStats own("one list");
+  ft::AllocationStats other("another list");
+  {
+    const alloc alloc_1(&own);
+    const alloc alloc_2(&other);
+    my::list_<int, alloc> my_lst(3, 1, alloc_1);
+    my::list_<int, alloc> my_lst_2(alloc_2);
+    my_lst_2 = std::move(my_lst);
+    EXPECT_EQ(my_lst_2.get_allocator(), alloc_1);
+    EXPECT_EQ(other.allocations(), 1u);
+    EXPECT_EQ(own.allocations(), 4u);
+  }
+  EXPECT_EQ(own.live_bytes(), 0u);
+  EXPECT_EQ(other.live_bytes(), 0u);
+}
+
+// =============================================================================
+// =========================== Unrolled list ===================================
+// =============================================================================
+
+template<class T, size_t K>
+void compare_unrolled(my::unrolled_list<T, K> &my_lst, stl::_list<T> &stl_lst) {
+  EXPECT_EQ(my_lst.size(), stl_lst.size())
+            << "\nLists x and y are of unequal length\n";
+  EXPECT_EQ(std::distance(my_lst.begin(), my_lst.end()),
+            std::distance(stl_lst.begin(), stl_lst.end()));
+  EXPECT_TRUE(std::equal(stl_lst.begin(), stl_lst.end(), my_lst.begin()))
+            << "list x and y differ";
+}
+
+// Node splits on insert keep element order.
+TEST(unrolled_list, insert) {
+  my::unrolled_list<int, 4> my_lst;
+  stl::_list<int> stl_lst;
+  for (int i = 0; i < 100; ++i) {
+    my_lst.push_back(i);
+    stl_lst.push_back(i);
+  }
+  auto my_iter = my_lst.begin();
+  auto stl_iter = stl_lst.begin();
+  for (int i = 0; i < 50; ++i) {
+    my_iter = my_lst.insert(my_iter, -i);
+    stl_iter = stl_lst.insert(stl_iter, -i);
+    EXPECT_EQ(*my_iter, *stl_iter);
+    std::advance(my_iter, 3);
+    std::advance(stl_iter, 3);
+  }
+  my_lst.insert(my_lst.begin(), 3, 7);
+  stl_lst.insert(stl_lst.begin(), 3, 7);
+  my_lst.push_front(42);
+  stl_lst.push_front(42);
+  compare_unrolled(my_lst, stl_lst);
+}
+
+// Node merges on erase keep element order.
+TEST(unrolled_list, erase) {
+  my::unrolled_list<std::string, 4> my_lst;
+  stl::_list<std::string> stl_lst;
+  for (int i = 0; i < 100; ++i) {
+    my_lst.push_back(std::to_string(i));
+    stl_lst.push_back(std::to_string(i));
+  }
+  auto my_iter = my_lst.begin();
+  auto stl_iter = stl_lst.begin();
+  for (; stl_iter != stl_lst.end(); ) {
+    my_iter = my_lst.erase(my_iter);
+    stl_iter = stl_lst.erase(stl_iter);
+    if (stl_iter != stl_lst.end()) {
+      EXPECT_EQ(*my_iter, *stl_iter);
+      ++my_iter;
+      ++stl_iter;
+    }
+  }
+  compare_unrolled(my_lst, stl_lst);
+  my_lst.erase(std::next(my_lst.begin(), 5), std::next(my_lst.begin(), 30));
+  stl_lst.erase(std::next(stl_lst.begin(), 5), std::next(stl_lst.begin(), 30));
+  compare_unrolled(my_lst, stl_lst);
+  while (!stl_lst.empty()) {
+    my_lst.pop_back();
+    stl_lst.pop_back();
+  }
+  compare_unrolled(my_lst, stl_lst);
+  EXPECT_EQ(my_lst.node_count(), 0u);
+}
+
+// Splicing moves whole nodes between lists.
+TEST(unrolled_list, splice) {
+  my::unrolled_list<int, 4> my_lst = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  my::unrolled_list<int, 4> my_other = {10, 11, 12, 13, 14, 15};
+  stl::_list<int> stl_lst = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  stl::_list<int> stl_other = {10, 11, 12, 13, 14, 15};
+  my_lst.splice(std::next(my_lst.begin(), 3), my_other,
+                std::next(my_other.begin()), std::next(my_other.begin(), 4));
+  stl_lst.splice(std::next(stl_lst.begin(), 3), stl_other,
+                 std::next(stl_other.begin()), std::next(stl_other.begin(), 4));
+  compare_unrolled(my_lst, stl_lst);
+  compare_unrolled(my_other, stl_other);
+  my_lst.splice(my_lst.end(), my_other);
+  stl_lst.splice(stl_lst.end(), stl_other);
+  compare_unrolled(my_lst, stl_lst);
+  compare_unrolled(my_other, stl_other);
+  // with the count given, the splice only touches the nodes at its ends
+  my_other.splice(my_other.begin(), my_lst, std::next(my_lst.begin(), 2),
+                  std::next(my_lst.begin(), 9), 7);
+  stl_other.splice(stl_other.begin(), stl_lst, std::next(stl_lst.begin(), 2),
+                   std::next(stl_lst.begin(), 9));
+  compare_unrolled(my_lst, stl_lst);
+  compare_unrolled(my_other, stl_other);
+  my_lst.splice(std::next(my_lst.begin()), my_lst,
+                std::next(my_lst.begin(), 3), my_lst.end(), my_lst.size() - 3);
+  stl_lst.splice(std::next(stl_lst.begin()), stl_lst,
+                 std::next(stl_lst.begin(), 3), stl_lst.end());
+  compare_unrolled(my_lst, stl_lst);
+}
+
+// Blocks come from the list's resource; a move to another resource moves the
+// elements and a nested list takes its outer list's resource.
+TEST(unrolled_list, polymorphic_allocator) {
+  ft::pmr::unsynchronized_pool_resource pool;
+  {
+    ft::pmr::monotonic_buffer_resource arena(&pool);
+    my::pmr::unrolled_list<int> my_lst(&arena);
+    stl::_list<int> stl_lst;
+    for (int i = 0; i < 1000; ++i) {
+      my_lst.push_back(i);
+      stl_lst.push_back(i);
+    }
+    my_lst.erase(std::next(my_lst.begin(), 100),
+                 std::next(my_lst.begin(), 400));
+    stl_lst.erase(std::next(stl_lst.begin(), 100),
+                  std::next(stl_lst.begin(), 400));
+    EXPECT_TRUE(std::equal(my_lst.begin(), my_lst.end(),
+                           stl_lst.begin(), stl_lst.end()));
+    my::pmr::unrolled_list<int> copy(my_lst);
+    EXPECT_EQ(copy.get_allocator().resource(),
+              ft::pmr::get_default_resource());
+    my::pmr::unrolled_list<int> other(&pool);
+    other = std::move(copy);
+    EXPECT_EQ(other.get_allocator().resource(), &pool);
+    EXPECT_TRUE(other == my_lst);
+    other = my_lst;
+    EXPECT_EQ(other.get_allocator().resource(), &pool);
+    my::pmr::unrolled_list<my::pmr::unrolled_list<int> > nested(&arena);
+    nested.emplace_back(3, 7);
+    EXPECT_EQ(nested.front().get_allocator().resource(), &arena);
+    EXPECT_EQ(nested.front().back(), 7);
+  }
+  {
+    std::pmr::unsynchronized_pool_resource std_pool;
+    my::unrolled_list<std::string, 8,
+                      std::pmr::polymorphic_allocator<std::string> >
+        my_lst(&std_pool);
+    for (int i = 0; i < 100; ++i) {
+      my_lst.push_front(std::to_string(i));
+    }
+    EXPECT_EQ(my_lst.size(), 100u);
+    EXPECT_EQ(my_lst.back(), "0");
+    EXPECT_EQ(my_lst.get_allocator().resource(), &std_pool);
+  }
+}
+
+// ============================= Index list ====================================
+// =============================================================================
+
+template<class T>
+void compare_index(my::index_list<T> &my_lst, stl::_list<T> &stl_lst) {
+  EXPECT_EQ(my_lst.size(), stl_lst.size())
+            << "\nLists x and y are of unequal length\n";
+  EXPECT_EQ(std::distance(my_lst.begin(), my_lst.end()),
+            std::distance(stl_lst.begin(), stl_lst.end()));
+  EXPECT_TRUE(std::equal(stl_lst.begin(), stl_lst.end(), my_lst.begin()))
+            << "list x and y differ";
+  EXPECT_TRUE(std::equal(stl_lst.rbegin(), stl_lst.rend(), my_lst.rbegin()))
+            << "list x and y differ in reverse";
+}
+
+// Erased slots are reused before the arena grows.
+TEST(index_list, insert_erase) {
+  my::index_list<std::string> my_lst;
+  stl::_list<std::string> stl_lst;
+  for (int i = 0; i < 100; ++i) {
+    my_lst.push_back(std::to_string(i));
+    stl_lst.push_back(std::to_string(i));
+  }
+  auto my_iter = my_lst.begin();
+  auto stl_iter = stl_lst.begin();
+  for (; stl_iter != stl_lst.end(); ) {
+    my_iter = my_lst.erase(my_iter);
+    stl_iter = stl_lst.erase(stl_iter);
+    if (stl_iter != stl_lst.end()) {
+      ++my_iter;
+      ++stl_iter;
+    }
+  }
+  compare_index(my_lst, stl_lst);
+  size_t capacity = my_lst.capacity();
+  for (int i = 0; i < 50; ++i) {
+    my_lst.push_front(std::to_string(-i));
+    stl_lst.push_front(std::to_string(-i));
+  }
+  EXPECT_EQ(my_lst.capacity(), capacity);
+  my_lst.insert(std::next(my_lst.begin(), 10), 3, "x");
+  stl_lst.insert(std::next(stl_lst.begin(), 10), 3, "x");
+  my_lst.erase(std::next(my_lst.begin(), 5), std::next(my_lst.begin(), 30));
+  stl_lst.erase(std::next(stl_lst.begin(), 5), std::next(stl_lst.begin(), 30));
+  compare_index(my_lst, stl_lst);
+}
+
+// Elements of the list itself may be inserted while the arena is full.
+TEST(index_list, insert_own_element) {
+  const std::string value(40, 'v');
+  my::index_list<std::string> my_lst;
+  stl::_list<std::string> stl_lst;
+  my_lst.reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    my_lst.push_back(value + std::to_string(i));
+    stl_lst.push_back(value + std::to_string(i));
+  }
+  ASSERT_EQ(my_lst.size(), my_lst.capacity());
+  my_lst.push_back(my_lst.front());
+  stl_lst.push_back(stl_lst.front());
+  compare_index(my_lst, stl_lst);
+  while (my_lst.size() < my_lst.capacity()) {
+    my_lst.push_front(value);
+    stl_lst.push_front(value);
+  }
+  my_lst.insert(std::next(my_lst.begin()), *std::prev(my_lst.end()));
+  stl_lst.insert(std::next(stl_lst.begin()), *std::prev(stl_lst.end()));
+  compare_index(my_lst, stl_lst);
+  const size_t n = my_lst.capacity();
+  my_lst.insert(my_lst.begin(), n, my_lst.back());
+  stl_lst.insert(stl_lst.begin(), n, stl_lst.back());
+  const size_t size = my_lst.capacity() + 5;
+  my_lst.resize(size, my_lst.front());
+  stl_lst.resize(size, stl_lst.front());
+  compare_index(my_lst, stl_lst);
+  // one element at a time the arena still grows geometrically
+  my::index_list<int> my_ints;
+  size_t growths = 0;
+  for (int i = 0; i < 10000; ++i) {
+    const size_t capacity = my_ints.capacity();
+    if (i % 2) {
+      my_ints.insert(my_ints.end(), 1, i);
+    } else {
+      my_ints.resize(my_ints.size() + 1, i);
+    }
+    growths += my_ints.capacity() != capacity;
+  }
+  EXPECT_LE(growths, 20u);
+  EXPECT_EQ(my_ints.back(), 9999);
+}
+
+// Splicing inside one list only relinks indices.
+TEST(index_list, splice) {
+  my::index_list<int> my_lst = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  my::index_list<int> my_other = {10, 11, 12, 13, 14, 15};
+  stl::_list<int> stl_lst = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  stl::_list<int> stl_other = {10, 11, 12, 13, 14, 15};
+  auto my_value = std::next(my_lst.begin(), 6);
+  my_lst.splice(std::next(my_lst.begin()), my_lst,
+                std::next(my_lst.begin(), 4), std::next(my_lst.begin(), 8));
+  stl_lst.splice(std::next(stl_lst.begin()), stl_lst,
+                 std::next(stl_lst.begin(), 4), std::next(stl_lst.begin(), 8));
+  EXPECT_EQ(*my_value, 7);
+  compare_index(my_lst, stl_lst);
+  my_lst.splice(my_lst.begin(), my_lst, std::prev(my_lst.end()));
+  stl_lst.splice(stl_lst.begin(), stl_lst, std::prev(stl_lst.end()));
+  compare_index(my_lst, stl_lst);
+  my_lst.splice(std::next(my_lst.begin(), 3), my_other,
+                std::next(my_other.begin()), std::next(my_other.begin(), 4));
+  stl_lst.splice(std::next(stl_lst.begin(), 3), stl_other,
+                 std::next(stl_other.begin()), std::next(stl_other.begin(), 4));
+  compare_index(my_lst, stl_lst);
+  compare_index(my_other, stl_other);
+  my_lst.splice(my_lst.end(), my_other);
+  stl_lst.splice(stl_lst.end(), stl_other);
+  compare_index(my_lst, stl_lst);
+  compare_index(my_other, stl_other);
+}
+
+// Sorting, reversing and compacting keep the list order.
+TEST(index_list, sort_compact) {
+  std::mt19937 gen(42);
+  my::index_list<int> my_lst;
+  stl::_list<int> stl_lst;
+  for (int i = 0; i < 1000; ++i) {
+    int value = static_cast<int>(gen() % 100);
+    my_lst.push_back(value);
+    stl_lst.push_back(value);
+  }
+  my_lst.remove_if([](int x) { return x % 3 == 0; });
+  stl_lst.remove_if([](int x) { return x % 3 == 0; });
+  my_lst.sort();
+  stl_lst.sort();
+  compare_index(my_lst, stl_lst);
+  my_lst.unique();
+  stl_lst.unique();
+  my_lst.reverse();
+  stl_lst.reverse();
+  compare_index(my_lst, stl_lst);
+  my_lst.compact();
+  EXPECT_EQ(my_lst.capacity(), my_lst.size());
+  compare_index(my_lst, stl_lst);
+  my_lst.push_back(-1);
+  stl_lst.push_back(-1);
+  my_lst.resize(10);
+  stl_lst.resize(10);
+  compare_index(my_lst, stl_lst);
+}
+
+// The arena and the elements come from the list's resource; a move to
+// another resource moves the elements.
+TEST(index_list, polymorphic_allocator) {
+  ft::pmr::unsynchronized_pool_resource pool;
+  {
+    ft::pmr::monotonic_buffer_resource arena(&pool);
+    my::pmr::index_list<int> my_lst(&arena);
+    stl::_list<int> stl_lst;
+    for (int i = 0; i < 1000; ++i) {
+      my_lst.push_back(i);
+      stl_lst.push_back(i);
+    }
+    my_lst.remove_if([](int x) { return x % 3 == 0; });
+    stl_lst.remove_if([](int x) { return x % 3 == 0; });
+    my_lst.compact();
+    EXPECT_TRUE(std::equal(my_lst.begin(), my_lst.end(),
+                           stl_lst.begin(), stl_lst.end()));
+    my::pmr::index_list<int> copy(my_lst);
+    EXPECT_EQ(copy.get_allocator().resource(),
+              ft::pmr::get_default_resource());
+    my::pmr::index_list<int> other(&pool);
+    other = std::move(copy);
+    EXPECT_EQ(other.get_allocator().resource(), &pool);
+    EXPECT_TRUE(other == my_lst);
+    my::pmr::index_list<int> moved(std::move(my_lst));
+    EXPECT_TRUE(my_lst.empty());
+    EXPECT_EQ(moved.get_allocator().resource(), &arena);
+    EXPECT_EQ(moved.back(), 998);
+    my::pmr::index_list<my::pmr::index_list<int> > nested(&arena);
+    nested.emplace_back(3, 7);
+    EXPECT_EQ(nested.front().get_allocator().resource(), &arena);
+    EXPECT_EQ(nested.front().back(), 7);
+  }
+  {
+    std::pmr::unsynchronized_pool_resource std_pool;
+    my::index_list<std::string, std::pmr::polymorphic_allocator<std::string> >
+        my_lst(&std_pool);
+    for (int i = 0; i < 100; ++i) {
+      my_lst.push_front(std::to_string(i));
+    }
+    EXPECT_EQ(my_lst.size(), 100u);
+    EXPECT_EQ(my_lst.back(), "0");
+    EXPECT_EQ(my_lst.get_allocator().resource(), &std_pool);
+  }
+}
+
 // =============================================================================
 // =============================== FINISH ======================================
 // =============================================================================
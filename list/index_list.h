@@ -0,0 +1,971 @@
+// -*- C++ -*-
+//===----------------------------- index list -----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include "tools/memory.h"
+#include "tools/memory_resource.h"
+#include "tools/reverse_iterator.h"
+#include "tools/utility.h"
+#include "vector/vector.h"
+#include "index_list_iterator.h"
+
+namespace ft {
+
+//  Doubly linked list whose nodes live in one ft::vector and are linked by
+//  32-bit indices.  Erased slots are chained into a free list and reused.
+//  Iterators stay valid while the arena grows; compact() renumbers the nodes
+//  in list order and invalidates them.
+template<class T, class Alloc = ft::Allocator<T> >
+class index_list {
+ public:
+  typedef uint32_t index_type;
+ private:
+  struct Node_;
+  template<typename, class> friend class index_list_iterator;
+/*
+**                                Public Types
+*/
+ public:
+  typedef T value_type;
+  typedef Alloc allocator_type;
+  typedef value_type &reference;
+  typedef const value_type &const_reference;
+  typedef typename std::allocator_traits<Alloc>::pointer pointer;
+  typedef typename std::allocator_traits<Alloc>::const_pointer const_pointer;
+  typedef ft::index_list_iterator<T, index_list> iterator;
+  typedef ft::index_list_iterator<const T, index_list> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+  typedef typename std::allocator_traits<Alloc>
+      ::template rebind_alloc<Node_> node_alloc_;
+/*
+**                           Public Member Functions
+*/
+  inline index_list();
+  inline explicit index_list(const allocator_type &a);
+  inline explicit index_list(size_type n,
+                             const allocator_type &a = allocator_type());
+  inline index_list(size_type n,
+                    const value_type &value,
+                    const allocator_type &a = allocator_type());
+  template<class Iter>
+  inline index_list(Iter first, Iter last,
+                    const allocator_type &a = allocator_type(),
+                    typename std::enable_if
+                        <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline index_list(const index_list &x);
+  inline index_list(index_list &&x);
+  inline index_list(const index_list &x, const allocator_type &a);
+  inline index_list(index_list &&x, const allocator_type &a);
+  inline index_list(std::initializer_list<value_type> l,
+                    const allocator_type &a = allocator_type());
+  inline virtual ~index_list() = default;
+  inline index_list &operator=(const index_list &x);
+  inline index_list &operator=(index_list &&x);
+  inline index_list &operator=(std::initializer_list<value_type> l);
+  template<class Iter>
+  inline void assign(Iter first, Iter last,
+                     typename std::enable_if
+                         <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline void assign(size_type n, const value_type &t);
+  inline allocator_type get_allocator() const noexcept;
+  inline iterator begin() noexcept;
+  inline const_iterator begin() const noexcept;
+  inline iterator end() noexcept;
+  inline const_iterator end() const noexcept;
+  inline reverse_iterator rbegin() noexcept;
+  inline const_reverse_iterator rbegin() const noexcept;
+  inline reverse_iterator rend() noexcept;
+  inline const_reverse_iterator rend() const noexcept;
+  inline const_iterator cbegin() const noexcept;
+  inline const_iterator cend() const noexcept;
+  inline reference front();
+  inline const_reference front() const;
+  inline reference back();
+  inline const_reference back() const;
+  inline bool empty() const noexcept;
+  inline size_type size() const noexcept;
+  inline size_type max_size() const noexcept;
+  inline size_type capacity() const noexcept;
+  inline void reserve(size_type n);
+  template<class... Args>
+  inline void emplace_front(Args &&... args);
+  template<class... Args>
+  inline void emplace_back(Args &&... args);
+  inline void push_front(const value_type &x);
+  inline void push_front(value_type &&x);
+  inline void push_back(const value_type &x);
+  inline void push_back(value_type &&x);
+  inline void pop_front();
+  inline void pop_back();
+  template<class... Args>
+  iterator emplace(const_iterator position, Args &&... args);
+  inline iterator insert(const_iterator position, const value_type &x);
+  inline iterator insert(const_iterator position, value_type &&x);
+  iterator insert(const_iterator position, size_type n, const value_type &x);
+  template<class Iter>
+  iterator insert(const_iterator position, Iter first, Iter last,
+                  typename std::enable_if
+                      <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline iterator insert(const_iterator position,
+                         std::initializer_list<value_type> il);
+  iterator erase(const_iterator position);
+  iterator erase(const_iterator first, const_iterator last);
+  void resize(size_type sz);
+  void resize(size_type sz, const value_type &c);
+  inline void swap(index_list &x) noexcept;
+  void clear() noexcept;
+  void splice(const_iterator position, index_list &x);
+  inline void splice(const_iterator position, index_list &&x);
+  inline void splice(const_iterator position, index_list &x, const_iterator i);
+  inline void splice(const_iterator position, index_list &&x,
+                     const_iterator i);
+  void splice(const_iterator position, index_list &x, const_iterator first,
+              const_iterator last);
+  inline void splice(const_iterator position, index_list &&x,
+                     const_iterator first, const_iterator last);
+  inline void remove(const value_type &value);
+  template<class Pred>
+  void remove_if(Pred pred);
+  inline void unique();
+  template<class BinaryPredicate>
+  void unique(BinaryPredicate binary_pred);
+  inline void sort();
+  template<class Compare>
+  void sort(Compare comp);
+  void reverse() noexcept;
+  void compact();
+ private:
+  static const index_type npos_ = 0xFFFFFFFF;
+  static const index_type free_ = 0xFFFFFFFE;
+
+  struct Node_ {
+    index_type next_;
+    index_type prev_;
+    typename std::aligned_storage<sizeof(value_type),
+                                  alignof(value_type)>::type storage_;
+
+    Node_() noexcept : next_(npos_), prev_(free_) {}
+    Node_(const Node_ &x) : next_(x.next_), prev_(x.prev_) {
+      if (x.prev_ != free_) {
+        new(&storage_) value_type(x.value());
+      }
+    }
+    Node_(Node_ &&x)
+    noexcept(std::is_nothrow_move_constructible<value_type>::value)
+        : next_(x.next_), prev_(x.prev_) {
+      if (x.prev_ != free_) {
+        new(&storage_) value_type(std::move(x.value()));
+      }
+    }
+    ~Node_() {
+      if (prev_ != free_) {
+        value().~value_type();
+      }
+    }
+    Node_ &operator=(const Node_ &x) {
+      Node_ copy(x);
+      return *this = std::move(copy);
+    }
+    Node_ &operator=(Node_ &&x) {
+      if (this == &x) {
+        return *this;
+      }
+      if (prev_ != free_) {
+        value().~value_type();
+        prev_ = free_;
+      }
+      if (x.prev_ != free_) {
+        new(&storage_) value_type(std::move(x.value()));
+      }
+      next_ = x.next_;
+      prev_ = x.prev_;
+      return *this;
+    }
+    value_type &value() {
+      return *reinterpret_cast<value_type *>(&storage_);
+    }
+    const value_type &value() const {
+      return *reinterpret_cast<const value_type *>(&storage_);
+    }
+  };
+
+  typedef std::allocator_traits<Alloc> alloc_traits_;
+  ft::vector<Node_, node_alloc_> nodes_;
+  index_type head_next_;
+  index_type head_prev_;
+  index_type free_list_;
+  size_type size_;
+  Alloc alloc_;
+
+  inline value_type &value_at_(index_type i);
+  inline index_type &next_of_(index_type i);
+  inline index_type &prev_of_(index_type i);
+  index_type get_slot_();
+  void grow_(size_type n);
+  void put_slot_(index_type i) noexcept;
+  void move_elements_(index_list &x);
+  template<class... Args>
+  void construct_(index_type i, Args &&... args);
+  void link_(index_type position, index_type i) noexcept;
+  void unlink_(index_type i) noexcept;
+  void unlink_range_(index_type first, index_type last) noexcept;
+  void link_range_(index_type position, index_type first,
+                   index_type last) noexcept;
+};
+
+template<class T, class Alloc>
+const typename index_list<T, Alloc>::index_type index_list<T, Alloc>::npos_;
+
+template<class T, class Alloc>
+const typename index_list<T, Alloc>::index_type index_list<T, Alloc>::free_;
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::value_type &
+    index_list<T, Alloc>::value_at_(index_type i) {
+  return nodes_[i].value();
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::index_type &
+    index_list<T, Alloc>::next_of_(index_type i) {
+  return i == npos_ ? head_next_ : nodes_[i].next_;
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::index_type &
+    index_list<T, Alloc>::prev_of_(index_type i) {
+  return i == npos_ ? head_prev_ : nodes_[i].prev_;
+}
+
+//  pops a slot off the free chain, growing the arena when it is empty
+template<class T, class Alloc>
+typename index_list<T, Alloc>::index_type index_list<T, Alloc>::get_slot_() {
+  if (free_list_ != npos_) {
+    index_type i = free_list_;
+    free_list_ = nodes_[i].next_;
+    return i;
+  }
+  if (nodes_.size() >= free_) {
+    throw ft::length_error("index_list");
+  }
+  nodes_.emplace_back();
+  return static_cast<index_type>(nodes_.size() - 1);
+}
+
+//  makes room for 'n' elements, at least doubling the arena so that
+//  repeated small inserts grow it geometrically
+template<class T, class Alloc>
+void index_list<T, Alloc>::grow_(size_type n) {
+  reserve(std::max(n, std::min(max_size(), 2 * nodes_.capacity())));
+}
+
+//  builds the value of a slot just taken; the slot goes back if that throws
+template<class T, class Alloc>
+template<class... Args>
+void index_list<T, Alloc>::construct_(index_type i, Args &&... args) {
+  try {
+    alloc_traits_::construct(alloc_, &nodes_[i].value(),
+                             std::forward<Args>(args) ...);
+  } catch (...) {
+    put_slot_(i);
+    throw;
+  }
+}
+
+//  moves the elements of 'x' into this empty list, for when its arena can't
+//  be taken over
+template<class T, class Alloc>
+void index_list<T, Alloc>::move_elements_(index_list &x) {
+  reserve(x.size_);
+  for (iterator i = x.begin(); i != x.end(); ++i) {
+    emplace_back(std::move(*i));
+  }
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::put_slot_(index_type i) noexcept {
+  nodes_[i].prev_ = free_;
+  nodes_[i].next_ = free_list_;
+  free_list_ = i;
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::link_(index_type position, index_type i) noexcept {
+  link_range_(position, i, i);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::unlink_(index_type i) noexcept {
+  unlink_range_(i, i);
+}
+
+//  detaches the closed range [first, last]
+template<class T, class Alloc>
+void index_list<T, Alloc>::unlink_range_(index_type first,
+                                         index_type last) noexcept {
+  index_type before = prev_of_(first);
+  index_type after = next_of_(last);
+  next_of_(before) = after;
+  prev_of_(after) = before;
+}
+
+//  links the closed range [first, last] before 'position'
+template<class T, class Alloc>
+void index_list<T, Alloc>::link_range_(index_type position,
+                                       index_type first,
+                                       index_type last) noexcept {
+  index_type before = prev_of_(position);
+  next_of_(last) = position;
+  prev_of_(first) = before;
+  next_of_(before) = first;
+  prev_of_(position) = last;
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list()
+    : nodes_(), head_next_(npos_), head_prev_(npos_), free_list_(npos_),
+      size_(0), alloc_() {}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(const allocator_type &a)
+    : nodes_(node_alloc_(a)), head_next_(npos_), head_prev_(npos_),
+      free_list_(npos_), size_(0), alloc_(a) {}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(size_type n, const allocator_type &a)
+    : index_list(a) {
+  reserve(n);
+  for (size_type i = 0; i < n; ++i) {
+    emplace_back();
+  }
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(size_type n,
+                                 const value_type &value,
+                                 const allocator_type &a)
+    : index_list(a) {
+  reserve(n);
+  for (size_type i = 0; i < n; ++i) {
+    emplace_back(value);
+  }
+}
+
+template<class T, class Alloc>
+template<class Iter>
+index_list<T, Alloc>::index_list(Iter first, Iter last,
+                                 const allocator_type &a,
+                                 typename std::enable_if
+                                     <!std::numeric_limits<Iter>::is_specialized>::type *)
+    : index_list(a) {
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(const index_list &x)
+    : index_list(x, alloc_traits_::select_on_container_copy_construction(
+          x.alloc_)) {}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(index_list &&x) : index_list(x.alloc_) {
+  *this = std::move(x);
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(const index_list &x, const allocator_type &a)
+    : index_list(a) {
+  reserve(x.size_);
+  for (const_iterator i = x.begin(); i != x.end(); ++i) {
+    emplace_back(*i);
+  }
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(index_list &&x, const allocator_type &a)
+    : index_list(a) {
+  if (alloc_ == x.alloc_) {
+    *this = std::move(x);
+    return;
+  }
+  move_elements_(x);
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc>::index_list(std::initializer_list<value_type> l,
+                                 const allocator_type &a)
+    : index_list(l.begin(), l.end(), a) {}
+
+template<class T, class Alloc>
+index_list<T, Alloc> &index_list<T, Alloc>::operator=(const index_list &x) {
+  if (this == &x) {
+    return *this;
+  }
+  //  the arena goes back to the allocator that made it before it is
+  //  replaced; the vector's own copy assignment takes x's node allocator
+  if (alloc_traits_::propagate_on_container_copy_assignment::value
+      && alloc_ != x.alloc_) {
+    ft::vector<Node_, node_alloc_> empty(x.nodes_.get_allocator());
+    clear();
+    nodes_ = empty;
+  }
+  ft::propagate_on_copy_assignment(alloc_, x.alloc_);
+  *this = index_list(x.begin(), x.end(), alloc_);
+  return *this;
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc> &index_list<T, Alloc>::operator=(index_list &&x) {
+  if (this == &x) {
+    return *this;
+  }
+  clear();
+  //  the arena of an unequal allocator can't be taken over
+  if (!alloc_traits_::propagate_on_container_move_assignment::value
+      && alloc_ != x.alloc_) {
+    move_elements_(x);
+    return *this;
+  }
+  nodes_ = std::move(x.nodes_);
+  head_next_ = x.head_next_;
+  head_prev_ = x.head_prev_;
+  free_list_ = x.free_list_;
+  size_ = x.size_;
+  ft::propagate_on_move_assignment(alloc_, x.alloc_);
+  x.clear();
+  return *this;
+}
+
+template<class T, class Alloc>
+index_list<T, Alloc> &index_list<T, Alloc>::operator=(
+    std::initializer_list<value_type> l) {
+  *this = index_list(l, alloc_);
+  return *this;
+}
+
+template<class T, class Alloc>
+template<class Iter>
+void index_list<T, Alloc>::assign(Iter first, Iter last,
+                                  typename std::enable_if
+                                      <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  *this = index_list(first, last, alloc_);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::assign(size_type n, const value_type &t) {
+  *this = index_list(n, t, alloc_);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::allocator_type
+    index_list<T, Alloc>::get_allocator() const noexcept {
+  return alloc_;
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::begin() noexcept {
+  return iterator(this, head_next_);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_iterator
+    index_list<T, Alloc>::begin() const noexcept {
+  return const_iterator(const_cast<index_list *>(this), head_next_);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator index_list<T, Alloc>::end() noexcept {
+  return iterator(this, npos_);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_iterator
+    index_list<T, Alloc>::end() const noexcept {
+  return const_iterator(const_cast<index_list *>(this), npos_);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::reverse_iterator
+    index_list<T, Alloc>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_reverse_iterator
+    index_list<T, Alloc>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::reverse_iterator
+    index_list<T, Alloc>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_reverse_iterator
+    index_list<T, Alloc>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_iterator
+    index_list<T, Alloc>::cbegin() const noexcept {
+  return begin();
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_iterator
+    index_list<T, Alloc>::cend() const noexcept {
+  return end();
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::reference index_list<T, Alloc>::front() {
+  return nodes_[head_next_].value();
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_reference
+    index_list<T, Alloc>::front() const {
+  return nodes_[head_next_].value();
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::reference index_list<T, Alloc>::back() {
+  return nodes_[head_prev_].value();
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::const_reference
+    index_list<T, Alloc>::back() const {
+  return nodes_[head_prev_].value();
+}
+
+template<class T, class Alloc>
+bool index_list<T, Alloc>::empty() const noexcept {
+  return !size_;
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::size_type
+    index_list<T, Alloc>::size() const noexcept {
+  return size_;
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::size_type
+    index_list<T, Alloc>::max_size() const noexcept {
+  return std::min<size_type>(nodes_.max_size(), free_);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::size_type
+    index_list<T, Alloc>::capacity() const noexcept {
+  return nodes_.capacity();
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::reserve(size_type n) {
+  if (n > max_size()) {
+    throw ft::length_error("index_list");
+  }
+  nodes_.reserve(n);
+}
+
+template<class T, class Alloc>
+template<class... Args>
+void index_list<T, Alloc>::emplace_front(Args &&... args) {
+  emplace(cbegin(), std::forward<Args>(args) ...);
+}
+
+template<class T, class Alloc>
+template<class... Args>
+void index_list<T, Alloc>::emplace_back(Args &&... args) {
+  emplace(cend(), std::forward<Args>(args) ...);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::push_front(const value_type &x) {
+  emplace(cbegin(), x);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::push_front(value_type &&x) {
+  emplace(cbegin(), std::move(x));
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::push_back(const value_type &x) {
+  emplace(cend(), x);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::push_back(value_type &&x) {
+  emplace(cend(), std::move(x));
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::pop_front() {
+  erase(cbegin());
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::pop_back() {
+  erase(const_iterator(this, head_prev_));
+}
+
+template<class T, class Alloc>
+template<class... Args>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::emplace(const_iterator position, Args &&... args) {
+  index_type i;
+  if (size_ == nodes_.capacity()) {
+    // args may refer to an element, which growing the arena moves
+    value_type value(std::forward<Args>(args) ...);
+    i = get_slot_();
+    construct_(i, std::move(value));
+  } else {
+    i = get_slot_();
+    construct_(i, std::forward<Args>(args) ...);
+  }
+  link_(position.index(), i);
+  ++size_;
+  return iterator(this, i);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::insert(const_iterator position,
+                                 const value_type &x) {
+  return emplace(position, x);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::insert(const_iterator position, value_type &&x) {
+  return emplace(position, std::move(x));
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::insert(const_iterator position,
+                                 size_type n,
+                                 const value_type &x) {
+  if (size_ + n > nodes_.capacity()) {
+    // x may be an element, which growing the arena moves
+    value_type copy_value(x);
+    grow_(size_ + n);
+    return insert(position, n, copy_value);
+  }
+  iterator first(position);
+  for (size_type i = 0; i < n; ++i) {
+    iterator current = emplace(position, x);
+    if (i == 0) {
+      first = current;
+    }
+  }
+  return first;
+}
+
+template<class T, class Alloc>
+template<class Iter>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::insert(const_iterator position,
+                                 Iter first,
+                                 Iter last,
+                                 typename std::enable_if
+                                     <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  iterator result(position);
+  for (bool is_first = true; first != last; ++first, is_first = false) {
+    iterator current = emplace(position, *first);
+    if (is_first) {
+      result = current;
+    }
+  }
+  return result;
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::insert(const_iterator position,
+                                 std::initializer_list<value_type> il) {
+  return insert(position, il.begin(), il.end());
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::erase(const_iterator position) {
+  index_type i = position.index();
+  index_type next = nodes_[i].next_;
+  unlink_(i);
+  alloc_traits_::destroy(alloc_, &nodes_[i].value());
+  put_slot_(i);
+  --size_;
+  return iterator(this, next);
+}
+
+template<class T, class Alloc>
+typename index_list<T, Alloc>::iterator
+    index_list<T, Alloc>::erase(const_iterator first, const_iterator last) {
+  while (first != last) {
+    first = erase(first);
+  }
+  return iterator(last);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::resize(size_type sz) {
+  while (size_ > sz) {
+    pop_back();
+  }
+  while (size_ < sz) {
+    emplace_back();
+  }
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::resize(size_type sz, const value_type &c) {
+  if (sz > nodes_.capacity()) {
+    // c may be an element, which growing the arena moves
+    value_type copy_value(c);
+    grow_(sz);
+    resize(sz, copy_value);
+    return;
+  }
+  while (size_ > sz) {
+    pop_back();
+  }
+  while (size_ < sz) {
+    emplace_back(c);
+  }
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::swap(index_list &x) noexcept {
+  nodes_.swap(x.nodes_);
+  std::swap(head_next_, x.head_next_);
+  std::swap(head_prev_, x.head_prev_);
+  std::swap(free_list_, x.free_list_);
+  std::swap(size_, x.size_);
+  ft::propagate_on_swap(alloc_, x.alloc_);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::clear() noexcept {
+  nodes_.clear();
+  head_next_ = head_prev_ = free_list_ = npos_;
+  size_ = 0;
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::splice(const_iterator position, index_list &x) {
+  splice(position, x, x.cbegin(), x.cend());
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::splice(const_iterator position, index_list &&x) {
+  splice(position, x);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::splice(const_iterator position,
+                                  index_list &x,
+                                  const_iterator i) {
+  const_iterator last = i;
+  splice(position, x, i, ++last);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::splice(const_iterator position,
+                                  index_list &&x,
+                                  const_iterator i) {
+  splice(position, x, i);
+}
+
+//  within one list the range is relinked in O(1); from another list the
+//  elements have to be moved into this arena one by one
+template<class T, class Alloc>
+void index_list<T, Alloc>::splice(const_iterator position,
+                                  index_list &x,
+                                  const_iterator first,
+                                  const_iterator last) {
+  if (first == last) {
+    return;
+  }
+  if (this == std::addressof(x)) {
+    if (position == first || position == last) {
+      return;
+    }
+    index_type n_first = first.index();
+    index_type n_last = prev_of_(last.index());
+    unlink_range_(n_first, n_last);
+    link_range_(position.index(), n_first, n_last);
+    return;
+  }
+  while (first != last) {
+    emplace(position, std::move_if_noexcept(*iterator(first)));
+    first = x.erase(first);
+  }
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::splice(const_iterator position,
+                                  index_list &&x,
+                                  const_iterator first,
+                                  const_iterator last) {
+  splice(position, x, first, last);
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::remove(const value_type &value) {
+  remove_if([&value](const value_type &x) { return x == value; });
+}
+
+template<class T, class Alloc>
+template<class Pred>
+void index_list<T, Alloc>::remove_if(Pred pred) {
+  for (const_iterator i = cbegin(); i != cend();) {
+    if (pred(*i)) {
+      i = erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::unique() {
+  unique(std::equal_to<value_type>());
+}
+
+template<class T, class Alloc>
+template<class BinaryPredicate>
+void index_list<T, Alloc>::unique(BinaryPredicate binary_pred) {
+  if (size_ < 2) {
+    return;
+  }
+  const_iterator prev = cbegin();
+  for (const_iterator i = std::next(prev); i != cend();) {
+    if (binary_pred(*prev, *i)) {
+      i = erase(i);
+    } else {
+      prev = i++;
+    }
+  }
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::sort() {
+  sort(std::less<value_type>());
+}
+
+//  sorts an array of node indices and relinks the nodes in one pass
+template<class T, class Alloc>
+template<class Compare>
+void index_list<T, Alloc>::sort(Compare comp) {
+  if (size_ < 2) {
+    return;
+  }
+  ft::vector<index_type> order;
+  order.reserve(size_);
+  for (index_type i = head_next_; i != npos_; i = nodes_[i].next_) {
+    order.push_back(i);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [this, &comp](index_type a, index_type b) {
+                     return comp(nodes_[a].value(), nodes_[b].value());
+                   });
+  index_type prev = npos_;
+  for (size_type k = 0; k < order.size(); ++k) {
+    next_of_(prev) = order[k];
+    nodes_[order[k]].prev_ = prev;
+    prev = order[k];
+  }
+  next_of_(prev) = npos_;
+  head_prev_ = prev;
+}
+
+template<class T, class Alloc>
+void index_list<T, Alloc>::reverse() noexcept {
+  index_type i = head_next_;
+  while (i != npos_) {
+    Node_ &node = nodes_[i];
+    std::swap(node.next_, node.prev_);
+    i = node.prev_;
+  }
+  std::swap(head_next_, head_prev_);
+}
+
+//  moves the elements into a fresh arena in list order, so traversal walks
+//  memory sequentially and the free slots are released
+template<class T, class Alloc>
+void index_list<T, Alloc>::compact() {
+  ft::vector<Node_, node_alloc_> nodes(nodes_.get_allocator());
+  nodes.reserve(size_);
+  index_type k = 0;
+  for (index_type i = head_next_; i != npos_; i = nodes_[i].next_, ++k) {
+    nodes.emplace_back();
+    Node_ &node = nodes[k];
+    alloc_traits_::construct(alloc_, &node.value(),
+                             std::move_if_noexcept(nodes_[i].value()));
+    node.prev_ = k == 0 ? npos_ : k - 1;
+    node.next_ = k + 1 == size_ ? npos_ : k + 1;
+  }
+  nodes_.swap(nodes);
+  head_next_ = size_ ? 0 : npos_;
+  head_prev_ = size_ ? static_cast<index_type>(size_ - 1) : npos_;
+  free_list_ = npos_;
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator==(const index_list<T, Alloc> &x, const index_list<T, Alloc> &y) {
+  return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator!=(const index_list<T, Alloc> &x, const index_list<T, Alloc> &y) {
+  return !(x == y);
+}
+
+template<class T, class Alloc>
+inline
+bool
+operator<(const index_list<T, Alloc> &x, const index_list<T, Alloc> &y) {
+  return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template<class T, class Alloc>
+inline
+void
+swap(index_list<T, Alloc> &x,
+     index_list<T, Alloc> &y) noexcept(noexcept(x.swap(y))) {
+  x.swap(y);
+}
+
+namespace pmr {
+
+template<class T>
+using index_list = ft::index_list<T, ft::pmr::polymorphic_allocator<T> >;
+
+}
+
+}
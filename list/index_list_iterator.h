@@ -0,0 +1,121 @@
+// -*- C++ -*-
+//===------------------------- index list iterator ------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "tools/utility.h"
+
+namespace ft {
+template<typename T, class List>
+class index_list_iterator {
+ public:
+  typedef T iterator_type;
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef typename remove_const<T>::type value_type;
+  typedef ptrdiff_t difference_type;
+  typedef typename qualifier_type<T>::pointer pointer;
+  typedef typename qualifier_type<T>::reference reference;
+  typedef typename List::index_type index_type;
+
+  inline index_list_iterator() = default;
+  inline ~index_list_iterator() = default;
+  inline index_list_iterator(List *list, index_type index);
+  inline index_list_iterator(index_list_iterator<value_type,
+                                                 List> const &other);
+  inline index_list_iterator(index_list_iterator<const value_type,
+                                                 List> const &other);
+  inline index_list_iterator &operator=(index_list_iterator const &other)
+  = default;
+  inline reference operator*() const;
+  inline pointer operator->() const;
+  inline index_list_iterator &operator++();
+  inline index_list_iterator &operator--();
+  inline index_list_iterator operator++(int);
+  inline index_list_iterator operator--(int);
+  inline bool operator==(const index_list_iterator &x) const;
+  inline bool operator!=(const index_list_iterator &x) const;
+  inline List *list() const;
+  inline index_type index() const;
+ private:
+  List *list_;
+  index_type index_;
+};
+
+template<typename T, class List>
+index_list_iterator<T, List>::index_list_iterator(List *list,
+                                                  index_type index)
+    : list_(list), index_(index) {}
+
+template<typename T, class List>
+index_list_iterator<T, List>::
+index_list_iterator(const index_list_iterator<value_type, List> &other)
+    : list_(other.list()), index_(other.index()) {}
+
+template<typename T, class List>
+index_list_iterator<T, List>::
+index_list_iterator(const index_list_iterator<const value_type, List> &other)
+    : list_(other.list()), index_(other.index()) {}
+
+template<typename T, class List>
+typename index_list_iterator<T, List>::
+reference index_list_iterator<T, List>::operator*() const {
+  return list_->value_at_(index_);
+}
+
+template<typename T, class List>
+typename index_list_iterator<T, List>::
+pointer index_list_iterator<T, List>::operator->() const {
+  return std::addressof(operator*());
+}
+
+template<typename T, class List>
+index_list_iterator<T, List> &index_list_iterator<T, List>::operator++() {
+  index_ = list_->next_of_(index_);
+  return *this;
+}
+
+template<typename T, class List>
+index_list_iterator<T, List> &index_list_iterator<T, List>::operator--() {
+  index_ = list_->prev_of_(index_);
+  return *this;
+}
+
+template<typename T, class List>
+index_list_iterator<T, List> index_list_iterator<T, List>::operator++(int) {
+  auto tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template<typename T, class List>
+index_list_iterator<T, List> index_list_iterator<T, List>::operator--(int) {
+  auto tmp = *this;
+  --*this;
+  return tmp;
+}
+
+template<typename T, class List>
+List *index_list_iterator<T, List>::list() const {
+  return list_;
+}
+
+template<typename T, class List>
+typename index_list_iterator<T, List>::index_type
+    index_list_iterator<T, List>::index() const {
+  return index_;
+}
+
+template<typename T, class List>
+bool index_list_iterator<T, List>
+::operator==(const index_list_iterator &x) const {
+  return index_ == x.index_ && list_ == x.list_;
+}
+
+template<typename T, class List>
+bool index_list_iterator<T, List>
+::operator!=(const index_list_iterator &x) const {
+  return !(*this == x);
+}
+
+}
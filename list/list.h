@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "tools/memory.h"
+#include "tools/memory_resource.h"
 #include "tools/reverse_iterator.h"
 #include "bidirectional_iterator.h"
 #include "tools/utility.h"
@@ -17,7 +22,8 @@
 
 namespace ft {
 
-template<class T, class Alloc = ft::Allocator<T> >
+template<class T, class Alloc = ft::Allocator<T>,
+    class SizePolicy = ft::list_eager_size>
 class list {
  private:
   struct Node_;
@@ -29,19 +35,21 @@ class list {
   typedef Alloc allocator_type;
   typedef value_type &reference;
   typedef const value_type &const_reference;
-  typedef typename allocator_type::pointer pointer;
-  typedef typename allocator_type::const_pointer const_pointer;
+  typedef typename std::allocator_traits<Alloc>::pointer pointer;
+  typedef typename std::allocator_traits<Alloc>::const_pointer const_pointer;
   typedef ft::bidirectional_iterator<T, Node_> iterator;
   typedef ft::bidirectional_iterator<const T, Node_> const_iterator;
   typedef ft::reverse_iterator<iterator> reverse_iterator;
   typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
   typedef ptrdiff_t difference_type;
   typedef size_t size_type;
-  typedef typename Alloc::template rebind<Node_>::other node_alloc_;
+  typedef typename std::allocator_traits<Alloc>
+      ::template rebind_alloc<Node_> node_alloc_;
 /*
 **                           Public Member Functions
 */
-  inline list() noexcept(std::is_nothrow_default_constructible<allocator_type>::value);
+  inline list()
+  noexcept(std::is_nothrow_default_constructible<allocator_type>::value);
   inline explicit list(const allocator_type &a);
   inline explicit list(size_type n, const allocator_type &a = allocator_type());
   inline list(size_type n,
@@ -51,7 +59,8 @@ class list {
   inline list(Iter first, Iter last, const allocator_type &a = allocator_type(),
               typename std::enable_if
                   <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
-  inline list(const list &list, const allocator_type &a = allocator_type());
+  inline list(const list &x);
+  inline list(const list &list, const allocator_type &a);
   inline list(list &&x)
   noexcept(std::is_nothrow_move_constructible<allocator_type>::value);
   inline list(list &&x, const allocator_type &a);
@@ -60,12 +69,15 @@ class list {
   inline virtual ~list();
   inline list &operator=(const list &x);
   inline list &operator=(list &&x)
-  noexcept(std::is_nothrow_move_assignable<allocator_type>::value);
+  noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment
+               ::value
+           || std::allocator_traits<Alloc>::is_always_equal::value);
   inline list &operator=(std::initializer_list<value_type>);
   template<class Iter>
   inline void assign(Iter first, Iter last,
                      typename std::enable_if
-                         <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+                         <!std::numeric_limits<Iter>::is_specialized>
+                         ::type * = 0);
   inline void assign(size_type n, const value_type &t);
   inline void assign(std::initializer_list<value_type>);
   inline allocator_type get_allocator() const noexcept;
@@ -106,9 +118,10 @@ class list {
                          size_type n,
                          const value_type &x);
   template<class Iter>
-  inline iterator insert(const_iterator position, Iter first, Iter last,
-                         typename std::enable_if
-                             <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline iterator insert(
+      const_iterator position, Iter first, Iter last,
+      typename std::enable_if
+          <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
   inline iterator insert(const_iterator position,
                          std::initializer_list<value_type> il);
   inline iterator erase(const_iterator position);
@@ -126,6 +139,10 @@ class list {
                      const_iterator last);
   inline void splice(const_iterator position, list &&x, const_iterator first,
                      const_iterator last);
+  inline void splice(const_iterator position, list &x, const_iterator first,
+                     const_iterator last, size_type n);
+  inline void splice(const_iterator position, list &&x, const_iterator first,
+                     const_iterator last, size_type n);
   inline void remove(const value_type &value);
   template<class Pred>
   inline void remove_if(Pred pred);
@@ -141,37 +158,85 @@ class list {
   void sort();
   template<class Compare>
   void sort(Compare comp);
+  template<class KeyOf>
+  void sort_by_key(KeyOf key_of);
   void reverse() noexcept;
+  void compact();
  private:
   struct Node_ {
     Node_ *next_;
     Node_ *prev_;
     value_type value_;
+    //  place in its node block, see list_node_blocks
+    unsigned slot_;
   };
+  typedef std::allocator_traits<Alloc> alloc_traits_;
+  typedef std::allocator_traits<node_alloc_> node_traits_;
   Node_ *head_;
   Alloc alloc_;
   node_alloc_ n_alloc_;
-  size_type size_;
+  mutable size_type size_;
+  mutable bool size_stale_ = false;
+  typedef ft::list_node_blocks<Node_, node_alloc_> node_blocks_;
+  //  a block stays allocated until its last node is released, so one
+  //  surviving node can keep up to kBlockBytes alive
+  static const size_type kBlockBytes = 1 << 16;
+  //  chains shorter than this take their nodes one by one
+  static const size_type kMinBlockNodes = 16;
+  static const size_type kMinGallop = 7;
+  static const size_type kPointerSortMin = 8;
+  static const bool kLazySize = std::is_same<SizePolicy,
+                                             ft::list_lazy_size>::value;
  protected:
   Node_ *get_node_();
   void put_node_(Node_ *p);
   void init_head_();
+  void swap_nodes_(list &x) noexcept;
+  void move_elements_(list &x);
   void link_node_(const_iterator position, Node_ *p);
+  void splice_nodes_(const_iterator position, const_iterator first,
+                     const_iterator last) noexcept;
+  template<class Compare>
+  const_iterator upper_bound_(const value_type &value, Compare comp) const;
+  template<class Pred>
+  static const_iterator gallop_(const_iterator first, const_iterator last,
+                                Pred pred, size_type &n);
+  template<class Compare>
+  void merge_sort_(Compare comp);
+  template<class Compare>
+  void pointer_sort_(Compare comp);
+  template<class Iter, class NodeOf>
+  void relink_(Iter first, Iter last, NodeOf node_of) noexcept;
   Node_ *create_node_without_value_();
   Node_ *create_node_with_lvalue_(const value_type &x);
   template<typename... Args>
   Node_ *create_node_with_args_(Args &&... args);
-  void default_append_(const_iterator position, size_type n);
-  void value_append_(const_iterator position, size_type n, const value_type &x);
+  template<class Construct>
+  void create_chain_(size_type n, Construct construct,
+                     Node_ *&first, Node_ *&last);
+  void destroy_chain_(Node_ *first) noexcept;
+  const_iterator at_(size_type n) const;
+  Node_ *link_chain_(const_iterator position, Node_ *first, Node_ *last,
+                     size_type n) noexcept;
+  Node_ *default_append_(const_iterator position, size_type n);
+  Node_ *value_append_(const_iterator position, size_type n,
+                       const value_type &x);
+  template<class Iter>
+  Node_ *range_append_(const_iterator position, Iter first, Iter last);
+  template<class Iter>
+  Node_ *range_append_(const_iterator position, Iter first, Iter last,
+                       std::input_iterator_tag);
   template<class Iter>
-  size_type range_append_(const_iterator position, Iter first, Iter last);
+  Node_ *range_append_(const_iterator position, Iter first, Iter last,
+                       std::forward_iterator_tag);
 };
 
-template<class T, class Alloc>
-typename list<T, Alloc>::Node_ *list<T, Alloc>::create_node_without_value_() {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::create_node_without_value_() {
   Node_ *p = get_node_();
   try {
-    alloc_.construct(&p->value_);
+    alloc_traits_::construct(alloc_, &p->value_);
   } catch (...) {
     put_node_(p);
     throw;
@@ -179,12 +244,12 @@ typename list<T, Alloc>::Node_ *list<T, Alloc>::create_node_without_value_() {
   return p;
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::Node_ *list<T, Alloc>::
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::Node_ *list<T, Alloc, SizePolicy>::
 create_node_with_lvalue_(const value_type &x) {
   Node_ *p = get_node_();
   try {
-    alloc_.construct(&p->value_, x);
+    alloc_traits_::construct(alloc_, &p->value_, x);
   } catch (...) {
     put_node_(p);
     throw;
@@ -192,13 +257,13 @@ create_node_with_lvalue_(const value_type &x) {
   return p;
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<typename... Args>
-typename list<T, Alloc>::Node_ *list<T, Alloc>::
+typename list<T, Alloc, SizePolicy>::Node_ *list<T, Alloc, SizePolicy>::
 create_node_with_args_(Args &&... args) {
   Node_ *p = get_node_();
   try {
-    alloc_.construct(&p->value_, std::forward<T>(args) ...);
+    alloc_traits_::construct(alloc_, &p->value_, std::forward<T>(args) ...);
   } catch (...) {
     put_node_(p);
     throw;
@@ -206,8 +271,9 @@ create_node_with_args_(Args &&... args) {
   return p;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::link_node_(list::const_iterator position, list::Node_ *p) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::link_node_(list::const_iterator position,
+                                            list::Node_ *p) {
   auto pos = position.base();
   p->next_ = pos;
   p->prev_ = pos->prev_;
@@ -215,386 +281,618 @@ void list<T, Alloc>::link_node_(list::const_iterator position, list::Node_ *p) {
   pos->prev_ = p;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::init_head_() {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::init_head_() {
   head_ = get_node_();
   head_->prev_ = head_;
   head_->next_ = head_;
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::Node_ *list<T, Alloc>::get_node_() {
-  return n_alloc_.allocate(1);
-}
-
-template<class T, class Alloc>
-void list<T, Alloc>::put_node_(list::Node_ *p) {
-  return n_alloc_.deallocate(p, 1);
-}
-
-template<class T, class Alloc>
-void list<T, Alloc>::default_append_(const_iterator position,
-                                     list::size_type n) {
-  for (size_type i = 0; i < n; ++i) {
-    try {
-      link_node_(position, create_node_without_value_());
-    } catch (...) {
-      erase(std::next(position, -static_cast<difference_type>(i)), position);
-      throw std::runtime_error("Error value append");
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::get_node_() {
+  return node_blocks_::allocate(n_alloc_);
+}
+
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::put_node_(list::Node_ *p) {
+  node_blocks_::release(n_alloc_, p);
+}
+
+//  builds a detached chain of 'n' nodes, taking them from blocks when there
+//  are enough of them; 'construct' builds each value in place.  If it throws,
+//  nothing is left allocated.
+template<class T, class Alloc, class SizePolicy>
+template<class Construct>
+void list<T, Alloc, SizePolicy>::create_chain_(list::size_type n,
+                                               Construct construct,
+                                               list::Node_ *&first,
+                                               list::Node_ *&last) {
+  const size_type block_size = std::max<size_type>(1, kBlockBytes
+      / sizeof(Node_));
+  Node_ *block = nullptr;
+  size_type block_used = 0;
+  size_type block_count = 0;
+  first = last = nullptr;
+  try {
+    for (size_type i = 0; i < n; ++i) {
+      Node_ *node;
+      if (n < kMinBlockNodes) {
+        node = get_node_();
+      } else {
+        if (block_used == block_count) {
+          size_type count = std::min(n - i, block_size);
+          block = node_blocks_::allocate(n_alloc_, count);
+          block_count = count;
+          block_used = 0;
+        }
+        node = block + block_used++;
+      }
+      try {
+        construct(&node->value_);
+      } catch (...) {
+        put_node_(node);
+        throw;
+      }
+      node->prev_ = last;
+      node->next_ = nullptr;
+      (last ? last->next_ : first) = node;
+      last = node;
     }
+  } catch (...) {
+    for (; block_used < block_count; ++block_used) {
+      put_node_(block + block_used);
+    }
+    destroy_chain_(first);
+    first = last = nullptr;
+    throw;
   }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::value_append_(const_iterator position,
-                                   list::size_type n,
-                                   const value_type &x) {
-  for (size_type i = 0; i < n; ++i) {
-    try {
-      link_node_(position, create_node_with_lvalue_(x));
-    } catch (...) {
-      erase(std::next(position, -static_cast<difference_type>(i)), position);
-      throw std::runtime_error("Error value append");
-    }
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::destroy_chain_(list::Node_ *first) noexcept {
+  while (first) {
+    Node_ *p = first;
+    first = first->next_;
+    alloc_traits_::destroy(alloc_, &p->value_);
+    put_node_(p);
   }
 }
 
-template<class T, class Alloc>
+//  links a chain made by create_chain_ before 'position'
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::link_chain_(
+        list::const_iterator position,
+        list::Node_ *first,
+        list::Node_ *last,
+        list::size_type n) noexcept {
+  Node_ *pos = position.base();
+  if (!first) {
+    return pos;
+  }
+  first->prev_ = pos->prev_;
+  pos->prev_->next_ = first;
+  last->next_ = pos;
+  pos->prev_ = last;
+  size_ += n;
+  return first;
+}
+
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::default_append_(
+        const_iterator position,
+        list::size_type n) {
+  Node_ *first;
+  Node_ *last;
+  create_chain_(n, [this](value_type *p) {
+    alloc_traits_::construct(alloc_, p);
+  }, first, last);
+  return link_chain_(position, first, last, n);
+}
+
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::value_append_(
+        const_iterator position,
+        list::size_type n,
+        const value_type &x) {
+  Node_ *first;
+  Node_ *last;
+  create_chain_(n, [this, &x](value_type *p) {
+    alloc_traits_::construct(alloc_, p, x);
+  }, first, last);
+  return link_chain_(position, first, last, n);
+}
+
+template<class T, class Alloc, class SizePolicy>
 template<class Iter>
-typename list<T, Alloc>::size_type list<T, Alloc>::range_append_(
-    list::const_iterator position,
-    Iter first,
-    Iter last) {
-  size_type size = 0;
-  for (; first != last; ++first) {
-    try {
-      link_node_(position, create_node_with_lvalue(*first));
-      ++size;
-    } catch (...) {
-      erase(std::next(position, -static_cast<difference_type>(size)), position);
-      throw std::runtime_error("Error range append");
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::range_append_(
+        list::const_iterator position,
+        Iter first,
+        Iter last) {
+  return range_append_(
+      position, first, last,
+      typename std::iterator_traits<Iter>::iterator_category());
+}
+
+//  the length of a single-pass range is unknown, so its nodes are
+//  allocated one at a time
+template<class T, class Alloc, class SizePolicy>
+template<class Iter>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::range_append_(
+        list::const_iterator position,
+        Iter first,
+        Iter last,
+        std::input_iterator_tag) {
+  Node_ *chain_first = nullptr;
+  Node_ *chain_last = nullptr;
+  size_type n = 0;
+  try {
+    for (; first != last; ++first, ++n) {
+      Node_ *node = create_node_with_lvalue_(*first);
+      node->prev_ = chain_last;
+      node->next_ = nullptr;
+      (chain_last ? chain_last->next_ : chain_first) = node;
+      chain_last = node;
     }
+  } catch (...) {
+    destroy_chain_(chain_first);
+    throw;
   }
-  return size;
+  return link_chain_(position, chain_first, chain_last, n);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::begin() noexcept {
+template<class T, class Alloc, class SizePolicy>
+template<class Iter>
+typename list<T, Alloc, SizePolicy>::Node_ *
+    list<T, Alloc, SizePolicy>::range_append_(
+        list::const_iterator position,
+        Iter first,
+        Iter last,
+        std::forward_iterator_tag) {
+  size_type n = std::distance(first, last);
+  Node_ *chain_first;
+  Node_ *chain_last;
+  create_chain_(n, [this, &first](value_type *p) {
+    alloc_traits_::construct(alloc_, p, *first);
+    ++first;
+  }, chain_first, chain_last);
+  return link_chain_(position, chain_first, chain_last, n);
+}
+
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::begin() noexcept {
   return iterator(head_->next_);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_iterator list<T, Alloc>::begin() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::begin() const noexcept {
   return const_iterator(head_->next_);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::end() noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::end() noexcept {
   return iterator(head_);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_iterator list<T, Alloc>::end() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::end() const noexcept {
   return const_iterator(head_);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rbegin() noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::reverse_iterator
+    list<T, Alloc, SizePolicy>::rbegin() noexcept {
   return reverse_iterator(end());
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_reverse_iterator list<T,
-                                                     Alloc>::rbegin() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_reverse_iterator
+    list<T, Alloc, SizePolicy>::rbegin() const noexcept {
   return const_reverse_iterator(end());
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rend() noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::reverse_iterator
+    list<T, Alloc, SizePolicy>::rend() noexcept {
   return reverse_iterator(begin());
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_reverse_iterator list<T,
-                                                     Alloc>::rend() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_reverse_iterator
+    list<T, Alloc, SizePolicy>::rend() const noexcept {
   return const_reverse_iterator(begin());
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_iterator list<T,
-                                             Alloc>::cbegin() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::cbegin() const noexcept {
   return begin();
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_iterator list<T, Alloc>::cend() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::cend() const noexcept {
   return end();
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_reverse_iterator list<T,
-                                                     Alloc>::crbegin() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_reverse_iterator
+    list<T, Alloc, SizePolicy>::crbegin() const noexcept {
   return rbegin();
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_reverse_iterator list<T,
-                                                     Alloc>::crend() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_reverse_iterator
+    list<T, Alloc, SizePolicy>::crend() const noexcept {
   return rend();
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::reference list<T, Alloc>::front() {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::reference
+    list<T, Alloc, SizePolicy>::front() {
   return head_->next_->value_;
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_reference list<T, Alloc>::front() const {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_reference
+    list<T, Alloc, SizePolicy>::front() const {
   return head_->next_->value_;
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::reference list<T, Alloc>::back() {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::reference
+    list<T, Alloc, SizePolicy>::back() {
   return head_->prev_->value_;
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::const_reference list<T, Alloc>::back() const {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_reference
+    list<T, Alloc, SizePolicy>::back() const {
   return head_->prev_->value_;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::push_back(const value_type &x) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::push_back(const value_type &x) {
   link_node_(cend(), create_node_with_lvalue_(x));
   ++size_;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::push_back(value_type &&x) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::push_back(value_type &&x) {
   link_node_(cend(), create_node_with_args_(std::forward<T>(x)));
   ++size_;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::push_front(const value_type &x) {
-  link_node_(cbegin(), create_node_with_args_(std::forward<T>(x)));
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::push_front(const value_type &x) {
+  link_node_(cbegin(), create_node_with_lvalue_(x));
   ++size_;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::push_front(value_type &&x) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::push_front(value_type &&x) {
   link_node_(cbegin(), create_node_with_args_(std::forward<T>(x)));
   ++size_;
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::list() noexcept(std::is_nothrow_default_constructible<
-    allocator_type>::value) : head_(), alloc_(), size_(0) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list()
+    noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+    : head_(), alloc_(), size_(0) {
   init_head_();
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::list(const allocator_type &a)
-    : head_(), alloc_(a), size_(0) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(const allocator_type &a)
+    : head_(), alloc_(a), n_alloc_(a), size_(0) {
   init_head_();
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::list(list::size_type n, const allocator_type &a)
-    : head_(), alloc_(a), size_(n) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(list::size_type n, const allocator_type &a)
+    : head_(), alloc_(a), n_alloc_(a), size_(0) {
   init_head_();
-  default_append_(cend(), n);
+  try {
+    default_append_(cend(), n);
+  } catch (...) {
+    put_node_(head_);
+    throw;
+  }
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::list(list::size_type n,
-                     const value_type &value,
-                     const allocator_type &a)
-    : head_(), alloc_(a), size_(n) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(list::size_type n,
+                                 const value_type &value,
+                                 const allocator_type &a)
+    : head_(), alloc_(a), n_alloc_(a), size_(0) {
   init_head_();
-  value_append_(cend(), n, value);
+  try {
+    value_append_(cend(), n, value);
+  } catch (...) {
+    put_node_(head_);
+    throw;
+  }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::clear() noexcept {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::clear() noexcept {
   erase(begin(), end());
   size_ = 0;
+  size_stale_ = false;
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::~list() {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::~list() {
   erase(begin(), end());
   put_node_(head_);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::pop_back() {
-  erase(const_iterator(head_->prev_), end());
-  --size_;
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::pop_back() {
+  erase(const_iterator(head_->prev_));
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::pop_front() {
-  erase(const_iterator(head_->next_), end());
-  --size_;
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::pop_front() {
+  erase(const_iterator(head_->next_));
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::erase(
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator list<T, Alloc, SizePolicy>::erase(
     list::const_iterator position) {
-  return erase(position, ++position);
+  const_iterator next = position;
+  return erase(position, ++next);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::erase(
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator list<T, Alloc, SizePolicy>::erase(
     list::const_iterator first,
     list::const_iterator last) {
-  Node_ *prev = std::next(first, -1).base();
-  for (; first != last;) {
-    ++first;
-    Node_ *p = std::next(first, -1).base();
-    alloc_.destroy(&p->value_);
-    put_node_(p);
+  Node_ *prev = first.base()->prev_;
+  Node_ *next = last.base();
+  for (Node_ *p = first.base(); p != next;) {
+    Node_ *current = p;
+    p = p->next_;
+    alloc_traits_::destroy(alloc_, &current->value_);
+    put_node_(current);
+    --size_;
   }
-  prev->next_ = head_;
-  head_->prev_ = prev;
-  return (last);
+  prev->next_ = next;
+  next->prev_ = prev;
+  return iterator(next);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class Iter>
-list<T, Alloc>::list(Iter first, Iter last, const allocator_type &a,
-                     typename std::enable_if
-                         <!std::numeric_limits<Iter>::is_specialized>::type *)
-    : alloc_(a), size_(0) {
+list<T, Alloc, SizePolicy>::list(
+    Iter first, Iter last, const allocator_type &a,
+    typename std::enable_if
+        <!std::numeric_limits<Iter>::is_specialized>::type *)
+    : alloc_(a), n_alloc_(a), size_(0) {
   init_head_();
   try {
     range_append_(cend(), first, last);
   } catch (...) {
     put_node_(head_);
+    throw;
   }
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::list(const list &list, const allocator_type &a) : list::list(
-    list.begin(),
-    list.end(),
-    a) {}
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(const list &x) : list::list(
+    x.begin(),
+    x.end(),
+    alloc_traits_::select_on_container_copy_construction(x.alloc_)) {}
+
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(const list &list, const allocator_type &a)
+    : list::list(list.begin(), list.end(), a) {}
 
-template<class T, class Alloc>
-list<T, Alloc>::list(list &&x) noexcept(std::is_nothrow_move_constructible<
-    allocator_type>::value) : size_(0) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(list &&x)
+    noexcept(std::is_nothrow_move_constructible<allocator_type>::value)
+    : alloc_(x.alloc_), n_alloc_(x.n_alloc_), size_(0) {
   init_head_();
-  *this = std::move(x);
+  swap_nodes_(x);
 }
 
-template<class T, class Alloc>
-list<T, Alloc>::list(list &&x, const allocator_type &a)
-    : list::list(x, get_allocator()), alloc_(a) {}
+//  nodes from an unequal allocator can't be taken over, so the elements are
+//  moved into new ones
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(list &&x, const allocator_type &a)
+    : list::list(a) {
+  if (alloc_ == x.alloc_) {
+    swap_nodes_(x);
+    return;
+  }
+  move_elements_(x);
+}
 
-template<class T, class Alloc>
-list<T, Alloc>::list(std::initializer_list<value_type> l,
-                     const allocator_type &a)
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy>::list(std::initializer_list<value_type> l,
+                                 const allocator_type &a)
     : list::list(
     l.begin(),
     l.end(),
     a) {}
 
-template<class T, class Alloc>
-list<T, Alloc> &list<T, Alloc>::operator=(const list &x) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy> &
+    list<T, Alloc, SizePolicy>::operator=(const list &x) {
   if (this == &x) {
     return *this;
   }
-  *this = std::move(list(x.begin(), x.end(), x.alloc_));
+  //  nodes, the head among them, go back to the allocator that made them
+  //  before it is replaced
+  if (alloc_traits_::propagate_on_container_copy_assignment::value
+      && alloc_ != x.alloc_) {
+    node_alloc_ n_alloc(x.n_alloc_);
+    Node_ *head = node_blocks_::allocate(n_alloc);
+    clear();
+    put_node_(head_);
+    head_ = head;
+    head_->prev_ = head_;
+    head_->next_ = head_;
+  }
+  ft::propagate_on_copy_assignment(alloc_, x.alloc_);
+  ft::propagate_on_copy_assignment(n_alloc_, x.n_alloc_);
+  assign(x.begin(), x.end());
   return *this;
 }
 
-template<class T, class Alloc>
-list<T, Alloc> &list<T, Alloc>::operator=(list &&x) noexcept(
-std::is_nothrow_move_assignable<allocator_type>::value) {
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy> &list<T, Alloc, SizePolicy>::operator=(list &&x)
+    noexcept(
+        std::allocator_traits<Alloc>::propagate_on_container_move_assignment
+            ::value
+        || std::allocator_traits<Alloc>::is_always_equal::value) {
   if (this == &x) {
     return *this;
   }
+  typedef typename alloc_traits_::propagate_on_container_move_assignment
+      propagate;
+  if (!propagate::value && alloc_ != x.alloc_) {
+    move_elements_(x);
+    return *this;
+  }
+  //  'x' is left with this list's head, so it takes this allocator too
   clear();
-  swap(x);
+  swap_nodes_(x);
+  memory_detail::swap_allocator(alloc_, x.alloc_, propagate());
+  memory_detail::swap_allocator(n_alloc_, x.n_alloc_, propagate());
   return *this;
 }
 
-template<class T, class Alloc>
-list<T, Alloc> &list<T, Alloc>::operator=(initializer_list<value_type> l) {
-  if (this == &l) {
-    return *this;
-  }
-  *this = std::move(list(l.begin(), l.end(), get_allocator()));
+template<class T, class Alloc, class SizePolicy>
+list<T, Alloc, SizePolicy> &
+    list<T, Alloc, SizePolicy>::operator=(std::initializer_list<value_type> l) {
+  assign(l.begin(), l.end());
   return *this;
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class Iter>
-void list<T, Alloc>::assign(Iter first, Iter last,
-                            typename std::enable_if
-                                <!std::numeric_limits<Iter>::is_specialized>::type *) {
-  list<T, Alloc> lst_(first, last, get_allocator());
-  *this = std::move(lst_);
+void list<T, Alloc, SizePolicy>::assign(
+    Iter first, Iter last,
+    typename std::enable_if
+        <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  iterator i = begin();
+  for (; i != end() && first != last; ++i, ++first) {
+    *i = *first;
+  }
+  if (first == last) {
+    erase(i, end());
+  } else {
+    range_append_(cend(), first, last);
+  }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::assign(list::size_type n, const value_type &t) {
-  list<T, Alloc> lst_(n, t, get_allocator());
-  *this = std::move(lst_);
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::assign(list::size_type n,
+                                        const value_type &t) {
+  iterator i = begin();
+  for (; i != end() && n > 0; ++i, --n) {
+    *i = t;
+  }
+  if (n == 0) {
+    erase(i, end());
+  } else {
+    value_append_(cend(), n, t);
+  }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::assign(initializer_list<value_type> l) {
-  *this = std::move(l);
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::assign(std::initializer_list<value_type> l) {
+  assign(l.begin(), l.end());
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::allocator_type list<T,
-                                             Alloc>::get_allocator() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::allocator_type
+    list<T, Alloc, SizePolicy>::get_allocator() const noexcept {
   return alloc_;
 }
 
-template<class T, class Alloc>
-bool list<T, Alloc>::empty() const noexcept {
-  return !size_;
+template<class T, class Alloc, class SizePolicy>
+bool list<T, Alloc, SizePolicy>::empty() const noexcept {
+  return head_->next_ == head_;
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::size_type list<T, Alloc>::size() const noexcept {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::size_type
+    list<T, Alloc, SizePolicy>::size() const noexcept {
+  if (kLazySize && size_stale_) {
+    size_ = std::distance(begin(), end());
+    size_stale_ = false;
+  }
   return size_;
 }
-template<class T, class Alloc>
-typename list<T, Alloc>::size_type list<T, Alloc>::max_size() const noexcept {
-  return std::min<size_type>(alloc_.max_size(),
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::size_type
+    list<T, Alloc, SizePolicy>::max_size() const noexcept {
+  return std::min<size_type>(alloc_traits_::max_size(alloc_),
                              std::numeric_limits<difference_type>::max());
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class... Args>
-void list<T, Alloc>::emplace_front(Args &&... args) {
+void list<T, Alloc, SizePolicy>::emplace_front(Args &&... args) {
   link_node_(cbegin(), create_node_with_args_(std::forward<T>(args)) ...);
   ++size_;
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class... Args>
-void list<T, Alloc>::emplace_back(Args &&... args) {
+void list<T, Alloc, SizePolicy>::emplace_back(Args &&... args) {
   link_node_(cend(), create_node_with_args_(std::forward<T>(args)) ...);
   ++size_;
 }
 
-template<class T, class Alloc>
-void list<T,
-          Alloc>::swap(list &x) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::swap(list &x)
+    noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+  swap_nodes_(x);
+  ft::propagate_on_swap(alloc_, x.alloc_);
+  ft::propagate_on_swap(n_alloc_, x.n_alloc_);
+}
+
+//  move-assigns the elements of 'x' over this list's, for when its nodes
+//  can't be taken over
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::move_elements_(list &x) {
+  iterator i = begin();
+  iterator j = x.begin();
+  for (; i != end() && j != x.end(); ++i, ++j) {
+    *i = std::move(*j);
+  }
+  if (j == x.end()) {
+    erase(i, end());
+    return;
+  }
+  for (; j != x.end(); ++j) {
+    emplace_back(std::move(*j));
+  }
+}
+
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::swap_nodes_(list &x) noexcept {
   std::swap(head_, x.head_);
   std::swap(size_, x.size_);
-  std::swap(alloc_, x.alloc_);
+  std::swap(size_stale_, x.size_stale_);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::splice(list::const_iterator position, list &x) {
-  if (x.size_ == 0) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &x) {
+  if (x.empty()) {
     return;
   }
   Node_ *p = position.base();
@@ -603,26 +901,69 @@ void list<T, Alloc>::splice(list::const_iterator position, list &x) {
   p->prev_->next_ = x.head_->next_;
   p->prev_ = x.head_->prev_;
   size_ += x.size_;
+  size_stale_ = size_stale_ || x.size_stale_;
   x.head_->prev_ = x.head_->next_ = x.head_;
   x.size_ = 0;
+  x.size_stale_ = false;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::splice(list::const_iterator position, list &&x) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &&x) {
   splice(position, x);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::splice(list::const_iterator position,
-                            list &x,
-                            list::const_iterator first,
-                            list::const_iterator last) {
-  size_type size = std::distance(first, last);
-  if (size == 0) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &x,
+                                        list::const_iterator first,
+                                        list::const_iterator last) {
+  if (first == last) {
+    return;
+  }
+  if (this == std::addressof(x)) {
+    splice_nodes_(position, first, last);
+  } else if (kLazySize) {
+    size_stale_ = x.size_stale_ = true;
+    splice_nodes_(position, first, last);
+  } else {
+    splice(position, x, first, last, std::distance(first, last));
+  }
+}
+
+//  'n' has to be std::distance(first, last); the caller already knows it, so
+//  the splice is O(1) under either size policy
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &x,
+                                        list::const_iterator first,
+                                        list::const_iterator last,
+                                        list::size_type n) {
+  if (first == last) {
     return;
   }
-  x.size_ -= size;
-  size_ += size;
+  if (this != std::addressof(x)) {
+    x.size_ -= n;
+    size_ += n;
+  }
+  splice_nodes_(position, first, last);
+}
+
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &&x,
+                                        list::const_iterator first,
+                                        list::const_iterator last,
+                                        list::size_type n) {
+  splice(position, x, first, last, n);
+}
+
+//  moves [first, last) before 'position' without touching any size
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice_nodes_(list::const_iterator position,
+                                               list::const_iterator first,
+                                               list::const_iterator last)
+                                               noexcept {
   Node_ *n_pos = position.base();
   Node_ *n_first = first.base();
   Node_ *n_last = last.base();
@@ -635,109 +976,123 @@ void list<T, Alloc>::splice(list::const_iterator position,
   n_last->next_ = n_pos;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::splice(list::const_iterator position,
-                            list &&x,
-                            list::const_iterator first,
-                            list::const_iterator last) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &&x,
+                                        list::const_iterator first,
+                                        list::const_iterator last) {
   splice(position, x, first, last);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::splice(list::const_iterator position,
-                            list &x,
-                            list::const_iterator i) {
-  splice(position, x, i, ++i);
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &x,
+                                        list::const_iterator i) {
+  const_iterator last = i;
+  if (position == i || position == ++last) {
+    return;
+  }
+  splice(position, x, i, last);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::splice(list::const_iterator position,
-                            list &&x,
-                            list::const_iterator i) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::splice(list::const_iterator position,
+                                        list &&x,
+                                        list::const_iterator i) {
   splice(position, x, i);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class... Args>
-typename list<T, Alloc>::iterator list<T, Alloc>::emplace(
-    list::const_iterator position,
-    Args &&... args) {
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::emplace(
+        list::const_iterator position,
+        Args &&... args) {
   Node_ *node = create_node_with_args_(std::forward<T>(args) ...);
   link_node_(position, node);
   ++size_;
   return iterator(node);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::insert(
-    list::const_iterator position,
-    const value_type &x) {
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::insert(
+        list::const_iterator position,
+        const value_type &x) {
   return insert(position, 1, x);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::insert(
-    list::const_iterator position,
-    value_type &&x) {
-  Node_ *node = create_node_with_args(std::move_if_noexcept(x));
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::insert(
+        list::const_iterator position,
+        value_type &&x) {
+  Node_ *node = create_node_with_args_(std::move(x));
   link_node_(position, node);
   ++size_;
   return iterator(node);
 }
 
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::insert(
-    list::const_iterator position,
-    list::size_type n,
-    const value_type &x) {
-  value_append_(position, n, x);
-  size_ += n;
-  return iterator(--position);
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::insert(
+        list::const_iterator position,
+        list::size_type n,
+        const value_type &x) {
+  return iterator(value_append_(position, n, x));
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class Iter>
-typename list<T, Alloc>::iterator list<T, Alloc>::insert(
-    list::const_iterator position,
-    Iter first,
-    Iter last,
-    typename std::enable_if
-        <!std::numeric_limits<Iter>::is_specialized>::type *) {
-  size_ += range_append_(position, first, last);
-  return iterator(--position);
-}
-
-template<class T, class Alloc>
-typename list<T, Alloc>::iterator list<T, Alloc>::insert(
-    list::const_iterator position,
-    std::initializer_list<value_type> il) {
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::insert(
+        list::const_iterator position,
+        Iter first,
+        Iter last,
+        typename std::enable_if
+            <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  return iterator(range_append_(position, first, last));
+}
+
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::iterator
+    list<T, Alloc, SizePolicy>::insert(
+        list::const_iterator position,
+        std::initializer_list<value_type> il) {
   return insert(position, il.begin(), il.end());
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::resize(list::size_type sz) {
-  if (sz > size_) {
-    default_append_(sz - size_);
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::resize(list::size_type sz) {
+  if (sz > size()) {
+    default_append_(cend(), sz - size_);
   } else if (sz < size_) {
-    const_iterator iter = begin();
-    std::advance(iter, sz);
-    erase(iter, end());
+    erase(at_(sz), end());
   }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::resize(list::size_type sz, const value_type &c) {
-  if (sz > size_) {
-    value_append(sz - size_, c);
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::resize(list::size_type sz,
+                                        const value_type &c) {
+  if (sz > size()) {
+    value_append_(cend(), sz - size_, c);
   } else if (sz < size_) {
-    const_iterator iter = begin();
-    std::advance(iter, sz);
-    erase(iter, end());
+    erase(at_(sz), end());
   }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::remove(const value_type &value) {
+//  walks to the element at 'n' from whichever end is closer
+template<class T, class Alloc, class SizePolicy>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::at_(list::size_type n) const {
+  if (n <= size() / 2) {
+    return std::next(cbegin(), n);
+  }
+  return std::prev(cend(), size_ - n);
+}
+
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::remove(const value_type &value) {
   for (const_iterator i = begin(), e = end(); i != e;) {
     if (*i == value) {
       const_iterator j = std::next(i);
@@ -752,9 +1107,9 @@ void list<T, Alloc>::remove(const value_type &value) {
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class Pred>
-void list<T, Alloc>::remove_if(Pred pred) {
+void list<T, Alloc, SizePolicy>::remove_if(Pred pred) {
   for (const_iterator i = begin(), e = end(); i != e;) {
     if (pred(*i)) {
       const_iterator j = std::next(i);
@@ -769,9 +1124,9 @@ void list<T, Alloc>::remove_if(Pred pred) {
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class BinaryPredicate>
-void list<T, Alloc>::unique(BinaryPredicate binary_pred) {
+void list<T, Alloc, SizePolicy>::unique(BinaryPredicate binary_pred) {
   for (const_iterator i = begin(), e = end(); i != e;) {
     const_iterator j = std::next(i);
     for (; j != e && binary_pred(*i, *j); ++j);
@@ -781,52 +1136,149 @@ void list<T, Alloc>::unique(BinaryPredicate binary_pred) {
   }
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::unique() {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::unique() {
   unique(std::equal_to<value_type>());
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::merge(list &x) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::merge(list &x) {
   merge(x, std::less<value_type>());
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class Compare>
-void list<T, Alloc>::merge(list &x, Compare comp) {
+void list<T, Alloc, SizePolicy>::merge(list &x, Compare comp) {
   if (this == std::addressof(x)) {
     return;
   }
-  iterator b_1 = begin();
-  iterator e_1 = end();
-  iterator b_2 = x.begin();
-  iterator e_2 = x.end();
-  while (b_1 != e_1 && b_2 != e_2) {
-    if (comp(*b_2, *b_1)) {
-      iterator current_2 = std::next(b_2);
-      for (; current_2 != e_2 && comp(*current_2, *b_1); ++current_2);
-      splice(b_1, x, b_2, current_2);
-      b_2 = current_2;
+  if (x.empty()) {
+    return;
+  }
+  const_iterator b_1 = upper_bound_(x.front(), comp);
+  const_iterator e_1 = cend();
+  while (b_1 != e_1 && !x.empty()) {
+    const value_type &pivot = *b_1;
+    size_type n = 1;
+    const_iterator e_2 = std::next(x.cbegin());
+    for (; e_2 != x.cend() && n < kMinGallop && comp(*e_2, pivot); ++e_2) {
+      ++n;
+    }
+    if (n == kMinGallop && e_2 != x.cend()) {
+      if (comp(x.back(), pivot)) {
+        break;
+      }
+      size_type k;
+      e_2 = gallop_(e_2, x.cend(), [&pivot, &comp](const value_type &v) {
+        return comp(v, pivot);
+      }, k);
+      n += k;
+    }
+    splice(b_1, x, x.cbegin(), e_2, n);
+    if (x.empty()) {
+      break;
+    }
+    const value_type &x_front = x.front();
+    size_type k = 0;
+    for (++b_1; b_1 != e_1 && k < kMinGallop && !comp(x_front, *b_1); ++b_1) {
+      ++k;
+    }
+    if (k == kMinGallop && b_1 != e_1) {
+      if (!comp(x_front, back())) {
+        b_1 = e_1;
+        break;
+      }
+      b_1 = gallop_(b_1, e_1, [&x_front, &comp](const value_type &v) {
+        return !comp(x_front, v);
+      }, k);
+    }
+  }
+  splice(b_1, x);
+}
+
+//  finds where 'value' goes in the sorted list, walking in from both ends
+//  at once, so the cost is the distance to the nearer end
+template<class T, class Alloc, class SizePolicy>
+template<class Compare>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::upper_bound_(const value_type &value,
+                                             Compare comp) const {
+  const_iterator lo = cbegin();
+  const_iterator hi = cend();
+  while (lo != hi) {
+    if (comp(value, *lo)) {
+      return lo;
+    }
+    if (++lo == hi) {
+      break;
+    }
+    const_iterator p = std::prev(hi);
+    if (!comp(value, *p)) {
+      return hi;
+    }
+    hi = p;
+  }
+  return lo;
+}
+
+//  returns the first element of [first, last) that fails 'pred', which has to
+//  hold for a prefix of the range; probes 1, 2, 4, ... nodes ahead and then
+//  bisects the last step, so a run of k elements costs O(log k) calls.
+//  'n' gets the length of that prefix.
+template<class T, class Alloc, class SizePolicy>
+template<class Pred>
+typename list<T, Alloc, SizePolicy>::const_iterator
+    list<T, Alloc, SizePolicy>::gallop_(const_iterator first,
+                                        const_iterator last,
+                                        Pred pred,
+                                        size_type &n) {
+  n = 0;
+  if (first == last || !pred(*first)) {
+    return first;
+  }
+  size_type step = 1;
+  size_type distance;
+  for (;;) {
+    const_iterator probe = first;
+    for (distance = 0; distance < step && probe != last; ++distance) {
+      ++probe;
+    }
+    if (probe == last || !pred(*probe)) {
+      break;
+    }
+    first = probe;
+    n += step;
+    step *= 2;
+  }
+  while (distance > 1) {
+    size_type half = distance / 2;
+    const_iterator mid = std::next(first, half);
+    if (pred(*mid)) {
+      first = mid;
+      n += half;
+      distance -= half;
+    } else {
+      distance = half;
     }
-    ++b_1;
   }
-  splice(e_1, x);
+  ++n;
+  return ++first;
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 template<class Compare>
-void list<T, Alloc>::merge(list &&x, Compare comp) {
+void list<T, Alloc, SizePolicy>::merge(list &&x, Compare comp) {
   merge(x, comp);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::merge(list &&x) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::merge(list &&x) {
   merge(x);
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::reverse() noexcept {
-  if (size_ <= 1) {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::reverse() noexcept {
+  if (head_->next_ == head_->prev_) {
     return;
   }
   iterator e = end();
@@ -837,72 +1289,179 @@ void list<T, Alloc>::reverse() noexcept {
   std::swap(head_->next_, head_->prev_);
 }
 
-template<class T, class Alloc>
+//  copies the elements into blocks of adjacent nodes in list order, so that
+//  traversal walks memory sequentially; invalidates every iterator but end().
+//  A list shorter than kMinBlockNodes would not get a block, so it is left
+//  as it is.  The old nodes are released, and so are their blocks once no
+//  other list holds a node of them.
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::compact() {
+  if (size() < kMinBlockNodes) {
+    return;
+  }
+  Node_ *current = head_->next_;
+  Node_ *first;
+  Node_ *last;
+  create_chain_(size_, [this, &current](value_type *p) {
+    alloc_traits_::construct(alloc_, p,
+                             std::move_if_noexcept(current->value_));
+    current = current->next_;
+  }, first, last);
+  size_type n = size_;
+  erase(begin(), end());
+  link_chain_(cend(), first, last, n);
+}
+
+template<class T, class Alloc, class SizePolicy>
+template<class Compare>
+void list<T, Alloc, SizePolicy>::sort(Compare comp) {
+  if (size() >= kPointerSortMin) {
+    pointer_sort_(comp);
+  } else {
+    merge_sort_(comp);
+  }
+}
+
+template<class T, class Alloc, class SizePolicy>
 template<class Compare>
-void list<T, Alloc>::sort(Compare comp) {
-  if (size_ <= 1)
+void list<T, Alloc, SizePolicy>::merge_sort_(Compare comp) {
+  if (size() <= 1)
     return;
   list divided(get_allocator());
   iterator b = begin();
   std::advance(b, size_ / 2);
-  divided.splice(divided.begin(), *this, b, end());
-  divided.sort();
-  sort();
-  merge(divided, comp);
+  divided.splice(divided.begin(), *this, b, end(), size_ - size_ / 2);
+  try {
+    divided.merge_sort_(comp);
+    merge_sort_(comp);
+    merge(divided, comp);
+  } catch (...) {
+    splice(end(), divided);
+    throw;
+  }
+}
+
+//  Sorts an array of node pointers and relinks the nodes in one pass, so
+//  comparisons never wait on a pointer chase through the list.  The links
+//  are untouched until the array is sorted.
+template<class T, class Alloc, class SizePolicy>
+template<class Compare>
+void list<T, Alloc, SizePolicy>::pointer_sort_(Compare comp) {
+  std::vector<Node_ *> nodes;
+  nodes.reserve(size_);
+  for (Node_ *p = head_->next_; p != head_; p = p->next_) {
+    nodes.push_back(p);
+  }
+  std::stable_sort(nodes.begin(), nodes.end(),
+                   [&comp](const Node_ *a, const Node_ *b) {
+                     return comp(a->value_, b->value_);
+                   });
+  relink_(nodes.begin(), nodes.end(), [](Node_ *p) { return p; });
+}
+
+//  Like sort(), ordering by a key cached next to each node pointer, which
+//  keeps the sort inside one contiguous array when the key is cheap to copy.
+template<class T, class Alloc, class SizePolicy>
+template<class KeyOf>
+void list<T, Alloc, SizePolicy>::sort_by_key(KeyOf key_of) {
+  typedef typename std::decay<decltype(key_of(head_->value_))>::type key_type;
+  typedef std::pair<key_type, Node_ *> entry;
+  if (size() <= 1)
+    return;
+  std::vector<entry> entries;
+  entries.reserve(size_);
+  for (Node_ *p = head_->next_; p != head_; p = p->next_) {
+    entries.push_back(entry(key_of(p->value_), p));
+  }
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const entry &a, const entry &b) {
+                     return a.first < b.first;
+                   });
+  relink_(entries.begin(), entries.end(),
+          [](const entry &e) { return e.second; });
+}
+
+template<class T, class Alloc, class SizePolicy>
+template<class Iter, class NodeOf>
+void list<T, Alloc, SizePolicy>::relink_(Iter first, Iter last,
+                                         NodeOf node_of) noexcept {
+  Node_ *prev = head_;
+  for (; first != last; ++first) {
+    Node_ *p = node_of(*first);
+    prev->next_ = p;
+    p->prev_ = prev;
+    prev = p;
+  }
+  prev->next_ = head_;
+  head_->prev_ = prev;
 }
 
-template<class T, class Alloc>
-void list<T, Alloc>::sort() {
+template<class T, class Alloc, class SizePolicy>
+void list<T, Alloc, SizePolicy>::sort() {
   sort(std::less<value_type>());
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 bool
-operator==(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+operator==(const list<T, Alloc, SizePolicy> &x,
+           const list<T, Alloc, SizePolicy> &y) {
   return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 bool
-operator<(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+operator<(const list<T, Alloc, SizePolicy> &x,
+          const list<T, Alloc, SizePolicy> &y) {
   return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 bool
-operator!=(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+operator!=(const list<T, Alloc, SizePolicy> &x,
+           const list<T, Alloc, SizePolicy> &y) {
   return !(x == y);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 bool
-operator>(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+operator>(const list<T, Alloc, SizePolicy> &x,
+          const list<T, Alloc, SizePolicy> &y) {
   return y < x;
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 bool
-operator>=(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+operator>=(const list<T, Alloc, SizePolicy> &x,
+           const list<T, Alloc, SizePolicy> &y) {
   return !(x < y);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 bool
-operator<=(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+operator<=(const list<T, Alloc, SizePolicy> &x,
+           const list<T, Alloc, SizePolicy> &y) {
   return !(y < x);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class SizePolicy>
 inline
 void
-swap(list<T, Alloc> &x, list<T, Alloc> &y) noexcept(noexcept(x.swap(y))) {
+swap(list<T, Alloc, SizePolicy> &x, list<T, Alloc, SizePolicy> &y)
+    noexcept(noexcept(x.swap(y))) {
   x.swap(y);
 }
 
+namespace pmr {
+
+template<class T, class SizePolicy = ft::list_eager_size>
+using list = ft::list<T, ft::pmr::polymorphic_allocator<T>, SizePolicy>;
+
+}
+
 }
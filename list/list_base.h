@@ -3,7 +3,76 @@
 //
 
 #pragma once
+#include <atomic>
+#include <memory>
+#include <new>
+
 namespace ft {
 
+//  Size policies for ft::list.  With the eager one size() is O(1) and a range
+//  splice between two lists counts the range; with the lazy one that splice
+//  is O(1) and the next size() call counts the list instead.
+struct list_eager_size {};
+struct list_lazy_size {};
+
+//  List nodes that were allocated together in one block rather than one by
+//  one.  Every block starts with a header that counts its live nodes, and
+//  every node keeps in an unsigned 'slot_' how many node places it sits
+//  past the start of its block, or 0 if it was allocated alone, so a node
+//  is released in O(1) without any record of the blocks.  Splice can
+//  scatter the nodes of a block over lists used by different threads, so
+//  the count is atomic; the last node released frees the block.
+template<class Node, class NodeAlloc>
+struct list_node_blocks {
+  typedef size_t size_type;
+  typedef std::allocator_traits<NodeAlloc> node_traits;
+
+  //  a node allocated alone
+  static Node *allocate(NodeAlloc &alloc) {
+    Node *p = node_traits::allocate(alloc, 1);
+    p->slot_ = 0;
+    return p;
+  }
+
+  //  allocates 'n' adjacent nodes in one block
+  static Node *allocate(NodeAlloc &alloc, size_type n) {
+    Node *raw = node_traits::allocate(alloc, n + kHeaderNodes);
+    ::new(static_cast<void *>(raw)) Block_(n);
+    for (size_type k = kHeaderNodes; k < n + kHeaderNodes; ++k) {
+      raw[k].slot_ = static_cast<unsigned>(k);
+    }
+    return raw + kHeaderNodes;
+  }
+
+  //  gives 'p' back, and its block once that was its last live node
+  static void release(NodeAlloc &alloc, Node *p) noexcept {
+    if (!p->slot_) {
+      node_traits::deallocate(alloc, p, 1);
+      return;
+    }
+    Block_ *block = reinterpret_cast<Block_ *>(p - p->slot_);
+    if (block->live_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    size_type n = block->size_ + kHeaderNodes;
+    block->~Block_();
+    node_traits::deallocate(alloc, reinterpret_cast<Node *>(block), n);
+  }
+
+
+ private:
+  struct Block_ {
+    explicit Block_(size_type n) : size_(n), live_(n) {}
+
+    size_type size_;
+    std::atomic<size_type> live_;
+  };
+
+  static_assert(alignof(Block_) <= alignof(Node),
+                "a block header must fit in front of the nodes");
+  //  the header takes the place of this many nodes
+  static const size_type kHeaderNodes
+      = (sizeof(Block_) + sizeof(Node) - 1) / sizeof(Node);
+};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,911 @@
+// -*- C++ -*-
+//===--------------------------- unrolled list ----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include "tools/memory.h"
+#include "tools/memory_resource.h"
+#include "tools/reverse_iterator.h"
+#include "tools/utility.h"
+#include "unrolled_list_iterator.h"
+
+namespace ft {
+
+//  elements per node: about 256 bytes of payload, never fewer than 4
+template<class T>
+struct unrolled_list_node_capacity {
+  static const size_t value = sizeof(T) >= 64 ? 4 : 256 / sizeof(T);
+};
+
+template<class T,
+         size_t K = unrolled_list_node_capacity<T>::value,
+         class Alloc = ft::Allocator<T> >
+class unrolled_list {
+  static_assert(K > 1, "unrolled_list needs at least two elements per node");
+ private:
+  struct Node_;
+/*
+**                                Public Types
+*/
+ public:
+  typedef T value_type;
+  typedef Alloc allocator_type;
+  typedef value_type &reference;
+  typedef const value_type &const_reference;
+  typedef typename std::allocator_traits<Alloc>::pointer pointer;
+  typedef typename std::allocator_traits<Alloc>::const_pointer const_pointer;
+  typedef ft::unrolled_list_iterator<T, Node_> iterator;
+  typedef ft::unrolled_list_iterator<const T, Node_> const_iterator;
+  typedef ft::reverse_iterator<iterator> reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef ptrdiff_t difference_type;
+  typedef size_t size_type;
+  typedef typename std::allocator_traits<Alloc>
+      ::template rebind_alloc<Node_> node_alloc_;
+/*
+**                           Public Member Functions
+*/
+  inline unrolled_list();
+  inline explicit unrolled_list(const allocator_type &a);
+  inline explicit unrolled_list(size_type n,
+                                const allocator_type &a = allocator_type());
+  inline unrolled_list(size_type n,
+                       const value_type &value,
+                       const allocator_type &a = allocator_type());
+  template<class Iter>
+  inline unrolled_list(Iter first, Iter last,
+                       const allocator_type &a = allocator_type(),
+                       typename std::enable_if
+                           <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline unrolled_list(const unrolled_list &x);
+  inline unrolled_list(unrolled_list &&x);
+  inline unrolled_list(const unrolled_list &x, const allocator_type &a);
+  inline unrolled_list(unrolled_list &&x, const allocator_type &a);
+  inline unrolled_list(std::initializer_list<value_type> l,
+                       const allocator_type &a = allocator_type());
+  inline virtual ~unrolled_list();
+  inline unrolled_list &operator=(const unrolled_list &x);
+  inline unrolled_list &operator=(unrolled_list &&x);
+  inline unrolled_list &operator=(std::initializer_list<value_type> l);
+  inline allocator_type get_allocator() const noexcept;
+  inline iterator begin() noexcept;
+  inline const_iterator begin() const noexcept;
+  inline iterator end() noexcept;
+  inline const_iterator end() const noexcept;
+  inline reverse_iterator rbegin() noexcept;
+  inline const_reverse_iterator rbegin() const noexcept;
+  inline reverse_iterator rend() noexcept;
+  inline const_reverse_iterator rend() const noexcept;
+  inline const_iterator cbegin() const noexcept;
+  inline const_iterator cend() const noexcept;
+  inline reference front();
+  inline const_reference front() const;
+  inline reference back();
+  inline const_reference back() const;
+  inline bool empty() const noexcept;
+  inline size_type size() const noexcept;
+  inline size_type max_size() const noexcept;
+  inline size_type node_count() const noexcept;
+  template<class... Args>
+  inline void emplace_front(Args &&... args);
+  template<class... Args>
+  inline void emplace_back(Args &&... args);
+  inline void push_front(const value_type &x);
+  inline void push_front(value_type &&x);
+  inline void push_back(const value_type &x);
+  inline void push_back(value_type &&x);
+  inline void pop_front();
+  inline void pop_back();
+  template<class... Args>
+  iterator emplace(const_iterator position, Args &&... args);
+  inline iterator insert(const_iterator position, const value_type &x);
+  inline iterator insert(const_iterator position, value_type &&x);
+  inline iterator insert(const_iterator position,
+                         size_type n,
+                         const value_type &x);
+  template<class Iter>
+  inline iterator insert(const_iterator position, Iter first, Iter last,
+                         typename std::enable_if
+                             <!std::numeric_limits<Iter>::is_specialized>::type * = 0);
+  inline iterator erase(const_iterator position);
+  iterator erase(const_iterator first, const_iterator last);
+  inline void swap(unrolled_list &x) noexcept;
+  void clear() noexcept;
+  void splice(const_iterator position, unrolled_list &x);
+  inline void splice(const_iterator position, unrolled_list &&x);
+  void splice(const_iterator position, unrolled_list &x,
+              const_iterator first, const_iterator last);
+  inline void splice(const_iterator position, unrolled_list &&x,
+                     const_iterator first, const_iterator last);
+  void splice(const_iterator position, unrolled_list &x,
+              const_iterator first, const_iterator last, size_type n);
+  inline void splice(const_iterator position, unrolled_list &&x,
+                     const_iterator first, const_iterator last, size_type n);
+ private:
+  struct Node_ {
+    Node_ *next_;
+    Node_ *prev_;
+    size_type count_;
+    typename std::aligned_storage<sizeof(value_type),
+                                  alignof(value_type)>::type storage_[K];
+    value_type *data() { return reinterpret_cast<value_type *>(storage_); }
+  };
+  typedef std::allocator_traits<Alloc> alloc_traits_;
+  typedef std::allocator_traits<node_alloc_> node_traits_;
+  Node_ *head_;
+  Alloc alloc_;
+  node_alloc_ n_alloc_;
+  size_type size_;
+ protected:
+  Node_ *get_node_();
+  void put_node_(Node_ *p);
+  void init_head_();
+  void swap_nodes_(unrolled_list &x) noexcept;
+  void move_elements_(unrolled_list &x);
+  void link_node_(Node_ *position, Node_ *p);
+  void unlink_node_(Node_ *p);
+  void transfer_(Node_ *from, size_type first, Node_ *to);
+  Node_ *split_before_(const_iterator position);
+  size_type splice_nodes_(const_iterator position, unrolled_list &x,
+                          const_iterator first, const_iterator last,
+                          bool count);
+  bool try_merge_(Node_ *p);
+  template<typename... Args>
+  void construct_at_(Node_ *p, size_type index, Args &&... args);
+};
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::Node_ *
+    unrolled_list<T, K, Alloc>::get_node_() {
+  Node_ *p = node_traits_::allocate(n_alloc_, 1);
+  p->count_ = 0;
+  return p;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::put_node_(Node_ *p) {
+  node_traits_::deallocate(n_alloc_, p, 1);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::init_head_() {
+  head_ = get_node_();
+  head_->prev_ = head_;
+  head_->next_ = head_;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::swap_nodes_(unrolled_list &x) noexcept {
+  std::swap(head_, x.head_);
+  std::swap(size_, x.size_);
+}
+
+//  moves the elements of 'x' into this empty list, for when its nodes can't
+//  be taken over
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::move_elements_(unrolled_list &x) {
+  for (iterator i = x.begin(); i != x.end(); ++i) {
+    emplace_back(std::move(*i));
+  }
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::link_node_(Node_ *position, Node_ *p) {
+  p->next_ = position;
+  p->prev_ = position->prev_;
+  position->prev_->next_ = p;
+  position->prev_ = p;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::unlink_node_(Node_ *p) {
+  p->prev_->next_ = p->next_;
+  p->next_->prev_ = p->prev_;
+}
+
+//  moves the elements [first, from->count_) of 'from' to the end of 'to'
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::transfer_(Node_ *from,
+                                           size_type first,
+                                           Node_ *to) {
+  size_type offset = to->count_;
+  size_type i = first;
+  try {
+    for (; i < from->count_; ++i) {
+      alloc_traits_::construct(alloc_, to->data() + offset + i - first,
+                               std::move_if_noexcept(from->data()[i]));
+    }
+  } catch (...) {
+    for (; i > first; --i) {
+      alloc_traits_::destroy(alloc_, to->data() + offset + i - first - 1);
+    }
+    throw;
+  }
+  for (i = first; i < from->count_; ++i) {
+    alloc_traits_::destroy(alloc_, from->data() + i);
+  }
+  to->count_ += from->count_ - first;
+  from->count_ = first;
+}
+
+//  returns the node that starts exactly at 'position', splitting if needed
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::Node_ *
+    unrolled_list<T, K, Alloc>::split_before_(const_iterator position) {
+  Node_ *node = position.base();
+  if (position.index() == 0) {
+    return node;
+  }
+  Node_ *p = get_node_();
+  try {
+    transfer_(node, position.index(), p);
+  } catch (...) {
+    put_node_(p);
+    throw;
+  }
+  link_node_(node->next_, p);
+  return p;
+}
+
+//  folds the successor of an underfull node into it
+template<class T, size_t K, class Alloc>
+bool unrolled_list<T, K, Alloc>::try_merge_(Node_ *p) {
+  Node_ *next = p->next_;
+  if (p == head_ || next == head_ || p->count_ + next->count_ > K ||
+      (p->count_ >= K / 2 && next->count_ >= K / 2)) {
+    return false;
+  }
+  transfer_(next, 0, p);
+  unlink_node_(next);
+  put_node_(next);
+  return true;
+}
+
+//  constructs an element at 'index' of a node that is not full
+template<class T, size_t K, class Alloc>
+template<typename... Args>
+void unrolled_list<T, K, Alloc>::construct_at_(Node_ *p,
+                                               size_type index,
+                                               Args &&... args) {
+  value_type *data = p->data();
+  if (index == p->count_) {
+    alloc_traits_::construct(alloc_, data + index,
+                             std::forward<Args>(args) ...);
+  } else {
+    value_type copy_value(std::forward<Args>(args) ...);
+    alloc_traits_::construct(alloc_, data + p->count_,
+                             std::move(data[p->count_ - 1]));
+    try {
+      std::move_backward(data + index, data + p->count_ - 1,
+                         data + p->count_);
+      data[index] = std::move(copy_value);
+    } catch (...) {
+      //  the tail slot is not counted yet, so nothing else would destroy it
+      alloc_traits_::destroy(alloc_, data + p->count_);
+      throw;
+    }
+  }
+  ++p->count_;
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list()
+    : head_(), alloc_(), n_alloc_(), size_(0) {
+  init_head_();
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(const allocator_type &a)
+    : head_(), alloc_(a), n_alloc_(a), size_(0) {
+  init_head_();
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(size_type n,
+                                          const allocator_type &a)
+    : unrolled_list(a) {
+  for (size_type i = 0; i < n; ++i) {
+    emplace_back();
+  }
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(size_type n,
+                                          const value_type &value,
+                                          const allocator_type &a)
+    : unrolled_list(a) {
+  for (size_type i = 0; i < n; ++i) {
+    emplace_back(value);
+  }
+}
+
+template<class T, size_t K, class Alloc>
+template<class Iter>
+unrolled_list<T, K, Alloc>::unrolled_list(Iter first, Iter last,
+                                          const allocator_type &a,
+                                          typename std::enable_if
+                                              <!std::numeric_limits<Iter>::is_specialized>::type *)
+    : unrolled_list(a) {
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(const unrolled_list &x)
+    : unrolled_list(x.begin(), x.end(),
+                    alloc_traits_::select_on_container_copy_construction(
+                        x.alloc_)) {}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(unrolled_list &&x)
+    : unrolled_list(x.alloc_) {
+  swap_nodes_(x);
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(const unrolled_list &x,
+                                          const allocator_type &a)
+    : unrolled_list(x.begin(), x.end(), a) {}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(unrolled_list &&x,
+                                          const allocator_type &a)
+    : unrolled_list(a) {
+  if (alloc_ == x.alloc_) {
+    swap_nodes_(x);
+    return;
+  }
+  move_elements_(x);
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::unrolled_list(std::initializer_list<value_type> l,
+                                          const allocator_type &a)
+    : unrolled_list(l.begin(), l.end(), a) {}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc>::~unrolled_list() {
+  clear();
+  put_node_(head_);
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc> &unrolled_list<T, K, Alloc>::operator=(
+    const unrolled_list &x) {
+  if (this == &x) {
+    return *this;
+  }
+  //  the nodes, the head among them, go back to the allocator that made
+  //  them before it is replaced
+  if (alloc_traits_::propagate_on_container_copy_assignment::value
+      && alloc_ != x.alloc_) {
+    node_alloc_ n_alloc(x.n_alloc_);
+    Node_ *head = node_traits_::allocate(n_alloc, 1);
+    clear();
+    put_node_(head_);
+    head_ = head;
+    head_->count_ = 0;
+    head_->prev_ = head_->next_ = head_;
+  }
+  ft::propagate_on_copy_assignment(alloc_, x.alloc_);
+  ft::propagate_on_copy_assignment(n_alloc_, x.n_alloc_);
+  unrolled_list copy(x.begin(), x.end(), alloc_);
+  swap_nodes_(copy);
+  return *this;
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc> &unrolled_list<T, K, Alloc>::operator=(
+    unrolled_list &&x) {
+  if (this == &x) {
+    return *this;
+  }
+  typedef typename alloc_traits_::propagate_on_container_move_assignment
+      propagate;
+  clear();
+  //  nodes from an unequal allocator can't be taken over
+  if (!propagate::value && alloc_ != x.alloc_) {
+    move_elements_(x);
+    return *this;
+  }
+  //  'x' is left with this list's head, so it takes this allocator too
+  swap_nodes_(x);
+  memory_detail::swap_allocator(alloc_, x.alloc_, propagate());
+  memory_detail::swap_allocator(n_alloc_, x.n_alloc_, propagate());
+  return *this;
+}
+
+template<class T, size_t K, class Alloc>
+unrolled_list<T, K, Alloc> &unrolled_list<T, K, Alloc>::operator=(
+    std::initializer_list<value_type> l) {
+  unrolled_list copy(l, alloc_);
+  swap_nodes_(copy);
+  return *this;
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::allocator_type
+    unrolled_list<T, K, Alloc>::get_allocator() const noexcept {
+  return alloc_;
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::begin() noexcept {
+  return iterator(head_->next_, 0);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_iterator
+    unrolled_list<T, K, Alloc>::begin() const noexcept {
+  return const_iterator(head_->next_, 0);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::end() noexcept {
+  return iterator(head_, 0);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_iterator
+    unrolled_list<T, K, Alloc>::end() const noexcept {
+  return const_iterator(head_, 0);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::reverse_iterator
+    unrolled_list<T, K, Alloc>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_reverse_iterator
+    unrolled_list<T, K, Alloc>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::reverse_iterator
+    unrolled_list<T, K, Alloc>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_reverse_iterator
+    unrolled_list<T, K, Alloc>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_iterator
+    unrolled_list<T, K, Alloc>::cbegin() const noexcept {
+  return begin();
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_iterator
+    unrolled_list<T, K, Alloc>::cend() const noexcept {
+  return end();
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::reference
+    unrolled_list<T, K, Alloc>::front() {
+  return head_->next_->data()[0];
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_reference
+    unrolled_list<T, K, Alloc>::front() const {
+  return head_->next_->data()[0];
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::reference
+    unrolled_list<T, K, Alloc>::back() {
+  return head_->prev_->data()[head_->prev_->count_ - 1];
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::const_reference
+    unrolled_list<T, K, Alloc>::back() const {
+  return head_->prev_->data()[head_->prev_->count_ - 1];
+}
+
+template<class T, size_t K, class Alloc>
+bool unrolled_list<T, K, Alloc>::empty() const noexcept {
+  return !size_;
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::size_type
+    unrolled_list<T, K, Alloc>::size() const noexcept {
+  return size_;
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::size_type
+    unrolled_list<T, K, Alloc>::max_size() const noexcept {
+  return std::min<size_type>(alloc_traits_::max_size(alloc_),
+                             std::numeric_limits<difference_type>::max());
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::size_type
+    unrolled_list<T, K, Alloc>::node_count() const noexcept {
+  size_type count = 0;
+  for (Node_ *p = head_->next_; p != head_; p = p->next_) {
+    ++count;
+  }
+  return count;
+}
+
+template<class T, size_t K, class Alloc>
+template<class... Args>
+void unrolled_list<T, K, Alloc>::emplace_front(Args &&... args) {
+  emplace(cbegin(), std::forward<Args>(args) ...);
+}
+
+template<class T, size_t K, class Alloc>
+template<class... Args>
+void unrolled_list<T, K, Alloc>::emplace_back(Args &&... args) {
+  Node_ *tail = head_->prev_;
+  if (tail != head_ && tail->count_ < K) {
+    alloc_traits_::construct(alloc_, tail->data() + tail->count_,
+                             std::forward<Args>(args) ...);
+    ++tail->count_;
+    ++size_;
+    return;
+  }
+  emplace(cend(), std::forward<Args>(args) ...);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::push_front(const value_type &x) {
+  emplace(cbegin(), x);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::push_front(value_type &&x) {
+  emplace(cbegin(), std::move(x));
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::push_back(const value_type &x) {
+  emplace_back(x);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::push_back(value_type &&x) {
+  emplace_back(std::move(x));
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::pop_front() {
+  erase(cbegin());
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::pop_back() {
+  erase(--cend());
+}
+
+template<class T, size_t K, class Alloc>
+template<class... Args>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::emplace(const_iterator position,
+                                        Args &&... args) {
+  Node_ *node = position.base();
+  size_type index = position.index();
+  if (index == 0 && node->prev_ != head_ && node->prev_->count_ < K) {
+    node = node->prev_;
+    index = node->count_;
+  } else if (index == 0 && (node == head_ || node->count_ == K)) {
+    Node_ *p = get_node_();
+    try {
+      alloc_traits_::construct(alloc_, p->data(), std::forward<Args>(args) ...);
+    } catch (...) {
+      put_node_(p);
+      throw;
+    }
+    p->count_ = 1;
+    link_node_(node, p);
+    ++size_;
+    return iterator(p, 0);
+  } else if (node->count_ == K) {
+    Node_ *p = split_before_(const_iterator(node, K / 2));
+    if (index > K / 2) {
+      node = p;
+      index -= K / 2;
+    }
+  }
+  construct_at_(node, index, std::forward<Args>(args) ...);
+  ++size_;
+  return iterator(node, index);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::insert(const_iterator position,
+                                       const value_type &x) {
+  return emplace(position, x);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::insert(const_iterator position,
+                                       value_type &&x) {
+  return emplace(position, std::move(x));
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::insert(const_iterator position,
+                                       size_type n,
+                                       const value_type &x) {
+  if (n == 0) {
+    return iterator(position);
+  }
+  iterator current = emplace(position, x);
+  for (size_type i = 1; i < n; ++i) {
+    current = emplace(++current, x);
+  }
+  std::advance(current, -static_cast<difference_type>(n - 1));
+  return current;
+}
+
+template<class T, size_t K, class Alloc>
+template<class Iter>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::insert(const_iterator position,
+                                       Iter first,
+                                       Iter last,
+                                       typename std::enable_if
+                                           <!std::numeric_limits<Iter>::is_specialized>::type *) {
+  if (first == last) {
+    return iterator(position);
+  }
+  iterator current = emplace(position, *first);
+  size_type n = 1;
+  for (++first; first != last; ++first, ++n) {
+    current = emplace(++current, *first);
+  }
+  std::advance(current, -static_cast<difference_type>(n - 1));
+  return current;
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::erase(const_iterator position) {
+  const_iterator next = position;
+  return erase(position, ++next);
+}
+
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::iterator
+    unrolled_list<T, K, Alloc>::erase(const_iterator first,
+                                      const_iterator last) {
+  size_type n = std::distance(first, last);
+  Node_ *node = first.base();
+  size_type index = first.index();
+  while (n) {
+    size_type count = std::min(n, node->count_ - index);
+    value_type *data = node->data();
+    std::move(data + index + count, data + node->count_, data + index);
+    for (size_type i = node->count_ - count; i < node->count_; ++i) {
+      alloc_traits_::destroy(alloc_, data + i);
+    }
+    node->count_ -= count;
+    size_ -= count;
+    n -= count;
+    if (node->count_ == 0) {
+      Node_ *next = node->next_;
+      unlink_node_(node);
+      put_node_(node);
+      node = next;
+      index = 0;
+    } else if (index == node->count_) {
+      node = node->next_;
+      index = 0;
+    }
+  }
+  if (index == 0 && node->prev_ != head_) {
+    Node_ *prev = node->prev_;
+    size_type offset = prev->count_;
+    if (try_merge_(prev)) {
+      node = prev;
+      index = offset;
+    }
+  } else {
+    try_merge_(node);
+  }
+  if (node != head_ && index == node->count_) {
+    node = node->next_;
+    index = 0;
+  }
+  return iterator(node, index);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::swap(unrolled_list &x) noexcept {
+  swap_nodes_(x);
+  ft::propagate_on_swap(alloc_, x.alloc_);
+  ft::propagate_on_swap(n_alloc_, x.n_alloc_);
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::clear() noexcept {
+  Node_ *p = head_->next_;
+  while (p != head_) {
+    Node_ *next = p->next_;
+    for (size_type i = 0; i < p->count_; ++i) {
+      alloc_traits_::destroy(alloc_, p->data() + i);
+    }
+    put_node_(p);
+    p = next;
+  }
+  head_->next_ = head_->prev_ = head_;
+  size_ = 0;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(const_iterator position,
+                                        unrolled_list &x) {
+  if (this == std::addressof(x) || x.size_ == 0) {
+    return;
+  }
+  Node_ *p = split_before_(position);
+  Node_ *first = x.head_->next_;
+  Node_ *last = x.head_->prev_;
+  first->prev_ = p->prev_;
+  p->prev_->next_ = first;
+  last->next_ = p;
+  p->prev_ = last;
+  size_ += x.size_;
+  x.head_->prev_ = x.head_->next_ = x.head_;
+  x.size_ = 0;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(const_iterator position,
+                                        unrolled_list &&x) {
+  splice(position, x);
+}
+
+//  splits the nodes at 'last', 'first' and 'position', moves the nodes of
+//  [first, last) from 'x' before 'position' and, if 'count' is set, returns
+//  how many elements they hold
+template<class T, size_t K, class Alloc>
+typename unrolled_list<T, K, Alloc>::size_type
+    unrolled_list<T, K, Alloc>::splice_nodes_(const_iterator position,
+                                              unrolled_list &x,
+                                              const_iterator first,
+                                              const_iterator last,
+                                              bool count) {
+  bool self = this == std::addressof(x);
+  Node_ *n_last = x.split_before_(last);
+  if (self && position.base() == last.base() &&
+      position.index() >= last.index() && last.index() != 0) {
+    position = const_iterator(n_last, position.index() - last.index());
+  }
+  Node_ *n_first = x.split_before_(first);
+  if (self && position.base() == first.base() &&
+      position.index() >= first.index() && first.index() != 0) {
+    position = const_iterator(n_first, position.index() - first.index());
+  }
+  Node_ *p = split_before_(position);
+  size_type n = 0;
+  for (Node_ *i = n_first; count && i != n_last; i = i->next_) {
+    n += i->count_;
+  }
+  Node_ *n_back = n_last->prev_;
+  n_first->prev_->next_ = n_last;
+  n_last->prev_ = n_first->prev_;
+  n_first->prev_ = p->prev_;
+  p->prev_->next_ = n_first;
+  n_back->next_ = p;
+  p->prev_ = n_back;
+  return n;
+}
+
+//  the moved nodes are counted, so a splice from another list is
+//  O(range / K); the overload that takes the count is O(1) apart from the
+//  splits
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(const_iterator position,
+                                        unrolled_list &x,
+                                        const_iterator first,
+                                        const_iterator last) {
+  if (first == last) {
+    return;
+  }
+  bool self = this == std::addressof(x);
+  size_type n = splice_nodes_(position, x, first, last, !self);
+  x.size_ -= n;
+  size_ += n;
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(const_iterator position,
+                                        unrolled_list &&x,
+                                        const_iterator first,
+                                        const_iterator last) {
+  splice(position, x, first, last);
+}
+
+//  'n' has to be std::distance(first, last); the caller already knows it, so
+//  only the nodes at the three ends are touched
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(const_iterator position,
+                                        unrolled_list &x,
+                                        const_iterator first,
+                                        const_iterator last,
+                                        size_type n) {
+  if (first == last) {
+    return;
+  }
+  splice_nodes_(position, x, first, last, false);
+  if (this != std::addressof(x)) {
+    x.size_ -= n;
+    size_ += n;
+  }
+}
+
+template<class T, size_t K, class Alloc>
+void unrolled_list<T, K, Alloc>::splice(const_iterator position,
+                                        unrolled_list &&x,
+                                        const_iterator first,
+                                        const_iterator last,
+                                        size_type n) {
+  splice(position, x, first, last, n);
+}
+
+template<class T, size_t K, class Alloc>
+inline
+bool
+operator==(const unrolled_list<T, K, Alloc> &x,
+           const unrolled_list<T, K, Alloc> &y) {
+  return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template<class T, size_t K, class Alloc>
+inline
+bool
+operator!=(const unrolled_list<T, K, Alloc> &x,
+           const unrolled_list<T, K, Alloc> &y) {
+  return !(x == y);
+}
+
+template<class T, size_t K, class Alloc>
+inline
+bool
+operator<(const unrolled_list<T, K, Alloc> &x,
+          const unrolled_list<T, K, Alloc> &y) {
+  return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template<class T, size_t K, class Alloc>
+inline
+void
+swap(unrolled_list<T, K, Alloc> &x,
+     unrolled_list<T, K, Alloc> &y) noexcept(noexcept(x.swap(y))) {
+  x.swap(y);
+}
+
+namespace pmr {
+
+template<class T, size_t K = ft::unrolled_list_node_capacity<T>::value>
+using unrolled_list =
+    ft::unrolled_list<T, K, ft::pmr::polymorphic_allocator<T> >;
+
+}
+
+}
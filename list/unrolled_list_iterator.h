@@ -0,0 +1,131 @@
+// -*- C++ -*-
+//===----------------------- unrolled list iterator -----------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include "tools/utility.h"
+
+namespace ft {
+template<typename T, class Node>
+class unrolled_list_iterator {
+ public:
+  typedef T iterator_type;
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef typename remove_const<T>::type value_type;
+  typedef ptrdiff_t difference_type;
+  typedef typename qualifier_type<T>::pointer pointer;
+  typedef typename qualifier_type<T>::reference reference;
+  typedef size_t size_type;
+
+  inline unrolled_list_iterator() = default;
+  inline ~unrolled_list_iterator() = default;
+  inline unrolled_list_iterator(Node *node, size_type index);
+  inline unrolled_list_iterator(unrolled_list_iterator<value_type,
+                                                       Node> const &other);
+  inline unrolled_list_iterator(unrolled_list_iterator<const value_type,
+                                                       Node> const &other);
+  inline unrolled_list_iterator &operator=(unrolled_list_iterator const &other)
+  = default;
+  inline reference operator*() const;
+  inline pointer operator->() const;
+  inline unrolled_list_iterator &operator++();
+  inline unrolled_list_iterator &operator--();
+  inline unrolled_list_iterator operator++(int);
+  inline unrolled_list_iterator operator--(int);
+  inline bool operator==(const unrolled_list_iterator &x) const;
+  inline bool operator!=(const unrolled_list_iterator &x) const;
+  inline Node *base() const;
+  inline size_type index() const;
+ private:
+  Node *node_;
+  size_type index_;
+};
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node>::unrolled_list_iterator(Node *node,
+                                                        size_type index)
+    : node_(node), index_(index) {}
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node>::
+unrolled_list_iterator(const unrolled_list_iterator<value_type, Node> &other)
+    : node_(other.base()), index_(other.index()) {}
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node>::
+unrolled_list_iterator(const unrolled_list_iterator<const value_type,
+                                                    Node> &other)
+    : node_(other.base()), index_(other.index()) {}
+
+template<typename T, class Node>
+typename unrolled_list_iterator<T, Node>::
+reference unrolled_list_iterator<T, Node>::operator*() const {
+  return node_->data()[index_];
+}
+
+template<typename T, class Node>
+typename unrolled_list_iterator<T, Node>::
+pointer unrolled_list_iterator<T, Node>::operator->() const {
+  return std::addressof(operator*());
+}
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node> &unrolled_list_iterator<T, Node>::operator++() {
+  if (++index_ == node_->count_) {
+    node_ = node_->next_;
+    index_ = 0;
+  }
+  return *this;
+}
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node> &unrolled_list_iterator<T, Node>::operator--() {
+  if (index_ == 0) {
+    node_ = node_->prev_;
+    index_ = node_->count_;
+  }
+  --index_;
+  return *this;
+}
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node> unrolled_list_iterator<T,
+                                                       Node>::operator++(int) {
+  auto tmp = *this;
+  ++*this;
+  return tmp;
+}
+
+template<typename T, class Node>
+unrolled_list_iterator<T, Node> unrolled_list_iterator<T,
+                                                       Node>::operator--(int) {
+  auto tmp = *this;
+  --*this;
+  return tmp;
+}
+
+template<typename T, class Node>
+Node *unrolled_list_iterator<T, Node>::base() const {
+  return node_;
+}
+
+template<typename T, class Node>
+typename unrolled_list_iterator<T, Node>::size_type
+    unrolled_list_iterator<T, Node>::index() const {
+  return index_;
+}
+
+template<typename T, class Node>
+bool unrolled_list_iterator<T, Node>
+::operator==(const unrolled_list_iterator &x) const {
+  return node_ == x.node_ && index_ == x.index_;
+}
+
+template<typename T, class Node>
+bool unrolled_list_iterator<T, Node>
+::operator!=(const unrolled_list_iterator &x) const {
+  return !(*this == x);
+}
+
+}
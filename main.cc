@@ -39,11 +39,11 @@ int main () {
     std_lst.push_back(i);
   }
   {
-    LOG_DURATION("TEST")
+    LOG_PERF("ft::list sort")
     my_lst.sort();
   }
   {
-    LOG_DURATION("TEST")
+    LOG_PERF("std::list sort")
     std_lst.sort();
   }
 //  for (const auto &item : my_lst) {
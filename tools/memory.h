@@ -6,12 +6,131 @@
 //===----------------------------------------------------------------------===//
 
 #pragma once
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <new>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include "exception.h"
 #include "utility.h"
 
 namespace ft {
+
+namespace memory_detail {
+
+//  zeroed blocks from this size up are mapped directly: they start out as
+//  zero pages and go back to the system as soon as they are freed
+const size_t kMapThreshold = size_t(1) << 21;
+
+inline void *map_pages(size_t bytes, const void *hint = nullptr) {
+  void *p = ::mmap(const_cast<void *>(hint), bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+inline void unmap_pages(void *p, size_t bytes) noexcept {
+  ::munmap(p, bytes);
+}
+
+//  resizes a mapping, moving it only if 'may_move'; nullptr on failure or
+//  where mremap is not available
+inline void *remap_pages(void *p, size_t old_bytes, size_t new_bytes,
+                         bool may_move) noexcept {
+#ifdef __linux__
+  void *q = ::mremap(p, old_bytes, new_bytes, may_move ? MREMAP_MAYMOVE : 0);
+  return q == MAP_FAILED ? nullptr : q;
+#else
+  (void)p, (void)old_bytes, (void)new_bytes, (void)may_move;
+  return nullptr;
+#endif
+}
+
+//  operator new and delete with the alignment and, where the language has
+//  sized deallocation, the size passed on, so the global allocator does not
+//  have to look the block up
+inline void *new_block(size_t bytes, size_t alignment) {
+#ifdef __cpp_aligned_new
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return ::operator new(bytes, std::align_val_t(alignment));
+  }
+#endif
+  (void)alignment;
+  return ::operator new(bytes);
+}
+
+inline void delete_block(void *p, size_t bytes, size_t alignment) noexcept {
+  (void)bytes, (void)alignment;
+#ifdef __cpp_aligned_new
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+#ifdef __cpp_sized_deallocation
+    ::operator delete(p, bytes, std::align_val_t(alignment));
+#else
+    ::operator delete(p, std::align_val_t(alignment));
+#endif
+    return;
+  }
+#endif
+#ifdef __cpp_sized_deallocation
+  ::operator delete(p, bytes);
+#else
+  ::operator delete(p);
+#endif
+}
+
+//  size and alignment of a transparent huge page on x86-64 and arm64
+const size_t kHugePage = size_t(1) << 21;
+
+inline size_t round_up(size_t bytes, size_t to) noexcept {
+  return (bytes + to - 1) / to * to;
+}
+
+//  maps 'bytes', a multiple of kHugePage, on a huge page boundary and asks
+//  for transparent huge pages.  Where they are unavailable or disabled the
+//  advice fails and the mapping keeps normal pages
+inline void *map_huge_pages(size_t bytes) {
+  const size_t span = bytes + kHugePage;
+  char *p = static_cast<char *>(map_pages(span));
+  char *aligned = reinterpret_cast<char *>(
+      round_up(reinterpret_cast<uintptr_t>(p), kHugePage));
+  if (aligned != p) {
+    unmap_pages(p, aligned - p);
+  }
+  if (p + span != aligned + bytes) {
+    unmap_pages(aligned + bytes, p + span - (aligned + bytes));
+  }
+#ifdef MADV_HUGEPAGE
+  ::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+  return aligned;
+}
+
+//  moves the pages of one mapping over another without copying them; false
+//  where mremap is not available or refuses
+inline bool move_pages(void *from, size_t from_bytes, void *to,
+                       size_t to_bytes) noexcept {
+#if defined(__linux__) && defined(MREMAP_FIXED)
+  return ::mremap(from, from_bytes, to_bytes,
+                  MREMAP_MAYMOVE | MREMAP_FIXED, to) != MAP_FAILED;
+#else
+  (void)from, (void)from_bytes, (void)to, (void)to_bytes;
+  return false;
+#endif
+}
+
+}
+
 template<class Tp>
 class Allocator;
 
@@ -52,6 +171,415 @@ class Allocator {
     return reinterpret_cast<pointer>(&x);
   }
 
+  //  allocates uninitialized storage with operator new; 'hint' is unused
+  pointer allocate(size_type size,
+                   __attribute__((unused))
+                   Allocator<void>::const_pointer hint = nullptr) {
+    const size_type bytes = checked_bytes_(size);
+    if (!large_(size)) {
+      return static_cast<pointer>(
+          memory_detail::new_block(bytes, alignof(value_type)));
+    }
+    return start_(memory_detail::new_block(bytes + header_(), header_()),
+                  false);
+  }
+
+  //  allocates storage whose bytes are all zero.  Large blocks are mapped
+  //  instead, as the zero pages they start out with cost nothing until
+  //  they are touched
+  pointer allocate_zeroed(size_type size) {
+    const size_type bytes = checked_bytes_(size);
+    if (!large_(size)) {
+      pointer p = allocate(size);
+      std::memset(static_cast<void *>(
+          const_cast<typename remove_const<T>::type *>(p)), 0, bytes);
+      return p;
+    }
+    return start_(memory_detail::map_pages(bytes + header_()), true);
+  }
+
+  //  resizes a block in place; false if it would have to move.  Only mapped
+  //  blocks can grow this way
+  bool try_expand(pointer p, size_type old_size,
+                  size_type new_size) const noexcept {
+    if (!large_(old_size) || !large_(new_size) || new_size >= max_size()
+        || !mapped_(p)) {
+      return false;
+    }
+    return memory_detail::remap_pages(
+        block_(p), old_size * sizeof(value_type) + header_(),
+        new_size * sizeof(value_type) + header_(), false) != nullptr;
+  }
+
+  //  moves a block of trivially copyable objects into one of 'new_size' and
+  //  returns it; mapped blocks are remapped instead of copied
+  pointer reallocate(pointer p, size_type old_size, size_type new_size) {
+    const size_type old_bytes = old_size * sizeof(value_type);
+    const size_type new_bytes = new_size * sizeof(value_type);
+    if (large_(old_size) && large_(new_size) && new_size < max_size()
+        && mapped_(p)) {
+      void *q = memory_detail::remap_pages(block_(p), old_bytes + header_(),
+                                           new_bytes + header_(), true);
+      if (q) {
+        return start_(q, true);
+      }
+    }
+    pointer q = allocate(new_size);
+    std::memcpy(static_cast<void *>(
+        const_cast<typename remove_const<T>::type *>(q)),
+                static_cast<const void *>(p),
+                std::min(old_bytes, new_bytes));
+    deallocate(p, old_size);
+    return q;
+  }
+
+  //  deallocates storage; 'size' must be the one passed to allocate
+  void deallocate(pointer p, size_type size) const noexcept {
+    const size_type bytes = size * sizeof(value_type);
+    if (!large_(size)) {
+      memory_detail::delete_block(
+          const_cast<typename remove_const<T>::type *>(p), bytes,
+          alignof(value_type));
+    } else if (mapped_(p)) {
+      memory_detail::unmap_pages(block_(p), bytes + header_());
+    } else {
+      memory_detail::delete_block(block_(p), bytes + header_(), header_());
+    }
+  }
+
+  //  returns the largest supported allocation size
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  //  constructs an object in allocated storage
+  template<class U, class... Args>
+  void construct(U *p, Args &&... args) const {
+    new(const_cast<
+            typename remove_const<U>::type *>(p)) U(std::forward<Args>(args) ...);
+  }
+
+  //  destructs an object in allocated storage
+  template<class U>
+  void destroy(U *p) const {
+    p->~U();
+  }
+
+ private:
+  //  Blocks of kMapThreshold bytes and up start with a header that records
+  //  whether allocate_zeroed mapped them; the objects follow it.
+  static bool large_(size_type size) noexcept {
+    return size * sizeof(value_type) >= memory_detail::kMapThreshold;
+  }
+
+  static constexpr size_type header_() noexcept {
+    return alignof(value_type) > alignof(std::max_align_t)
+           ? alignof(value_type) : alignof(std::max_align_t);
+  }
+
+  size_type checked_bytes_(size_type size) const {
+    if (size >= max_size() || size * sizeof(value_type)
+        > std::numeric_limits<size_type>::max() - header_()) {
+      throw ft::length_error("allocator<T>::allocate(size_t n) 'n'"
+                             " exceeds maximum supported size");
+    }
+    return size * sizeof(value_type);
+  }
+
+  static pointer start_(void *block, bool mapped) noexcept {
+    *static_cast<bool *>(block) = mapped;
+    return reinterpret_cast<pointer>(static_cast<char *>(block) + header_());
+  }
+
+  static char *block_(pointer p) noexcept {
+    return reinterpret_cast<char *>(
+        const_cast<typename remove_const<T>::type *>(p)) - header_();
+  }
+
+  static bool mapped_(pointer p) noexcept {
+    return *reinterpret_cast<bool *>(block_(p));
+  }
+};
+
+template<class T, class U>
+bool operator==(__attribute__((unused)) const Allocator<T> &target,
+                __attribute__((unused)) const Allocator<U> &other) noexcept {
+  return true;
+}
+
+template<class T, class U>
+bool operator!=(const Allocator<T> &target,
+                const Allocator<U> &other) noexcept {
+  return !(target == other);
+}
+
+//  true if 'Alloc' can hand out zeroed storage with allocate_zeroed(n)
+template<class Alloc, class = void>
+struct has_allocate_zeroed : std::false_type {};
+
+template<class Alloc>
+struct has_allocate_zeroed<Alloc, decltype(void(
+    std::declval<Alloc &>().allocate_zeroed(size_t())))> : std::true_type {};
+
+//  alignment of every block from 'Alloc': its 'alignment' member if it has
+//  one, else only what the element type needs
+template<class Alloc, class = void>
+struct allocator_alignment
+    : std::integral_constant<size_t, alignof(typename Alloc::value_type)> {};
+
+template<class Alloc>
+struct allocator_alignment<Alloc, decltype(void(Alloc::alignment))>
+    : std::integral_constant<size_t, Alloc::alignment> {};
+
+//  true if 'Alloc' has try_expand(p, old_size, new_size)
+template<class Alloc, class = void>
+struct has_try_expand : std::false_type {};
+
+template<class Alloc>
+struct has_try_expand<Alloc, decltype(void(
+    std::declval<Alloc &>().try_expand(
+        std::declval<typename Alloc::pointer>(), size_t(), size_t())))>
+    : std::true_type {};
+
+//  true if 'Alloc' has reallocate(p, old_size, new_size)
+template<class Alloc, class = void>
+struct has_reallocate : std::false_type {};
+
+template<class Alloc>
+struct has_reallocate<Alloc, decltype(void(
+    std::declval<Alloc &>().reallocate(
+        std::declval<typename Alloc::pointer>(), size_t(), size_t())))>
+    : std::true_type {};
+
+namespace memory_detail {
+
+template<class Alloc>
+void assign_allocator(Alloc &to, const Alloc &from, std::true_type) {
+  to = from;
+}
+
+template<class Alloc>
+void assign_allocator(Alloc &, const Alloc &, std::false_type) {}
+
+template<class Alloc>
+void move_allocator(Alloc &to, Alloc &from, std::true_type) {
+  to = std::move(from);
+}
+
+template<class Alloc>
+void move_allocator(Alloc &, Alloc &, std::false_type) {}
+
+template<class Alloc>
+void swap_allocator(Alloc &a, Alloc &b, std::true_type) {
+  using std::swap;
+  swap(a, b);
+}
+
+template<class Alloc>
+void swap_allocator(Alloc &, Alloc &, std::false_type) {}
+
+}
+
+//  A container's allocator follows its contents on copy assignment, move
+//  assignment and swap only where the allocator's propagate_on_container_*
+//  trait says so; otherwise these leave 'to' alone.
+template<class Alloc>
+void propagate_on_copy_assignment(Alloc &to, const Alloc &from) {
+  memory_detail::assign_allocator(to, from,
+      typename std::allocator_traits<Alloc>
+          ::propagate_on_container_copy_assignment());
+}
+
+template<class Alloc>
+void propagate_on_move_assignment(Alloc &to, Alloc &from) {
+  memory_detail::move_allocator(to, from,
+      typename std::allocator_traits<Alloc>
+          ::propagate_on_container_move_assignment());
+}
+
+template<class Alloc>
+void propagate_on_swap(Alloc &a, Alloc &b) {
+  memory_detail::swap_allocator(a, b,
+      typename std::allocator_traits<Alloc>::propagate_on_container_swap());
+}
+
+//  Hands out single objects from chunks of 'ChunkSize' slots and keeps freed
+//  slots on a per-thread free list.  Array requests go straight to
+//  ft::Allocator.  Chunks are never returned to the system, as their slots
+//  may be in use on any thread; instead a thread that exits hands its free
+//  slots to a shared list, which the next thread to run dry takes over, so
+//  short-lived threads do not each leave a set of chunks behind.
+template<class T, size_t ChunkSize = 64>
+class PoolAllocator {
+ public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T value_type;
+
+  template<class U>
+  struct rebind { typedef PoolAllocator<U, ChunkSize> other; };
+
+  constexpr PoolAllocator() noexcept = default;
+  ~PoolAllocator() noexcept = default;
+  template<class U>
+  constexpr explicit PoolAllocator(__attribute__((unused))
+                                   const PoolAllocator<U, ChunkSize> &other)
+                                   noexcept {};
+
+  //  allocates uninitialized storage
+  pointer allocate(size_type size,
+                   __attribute__((unused)) Allocator<void>::const_pointer hint = nullptr) {
+    if (size != 1) {
+      return Allocator<T>().allocate(size);
+    }
+    Slot_ *&free_list = free_list_();
+    if (!free_list) {
+      refill_(free_list);
+    }
+    Slot_ *slot = free_list;
+    free_list = slot->next_;
+    return reinterpret_cast<pointer>(slot);
+  }
+
+  //  deallocates storage
+  void deallocate(pointer p, size_type size) const noexcept {
+    if (size != 1) {
+      Allocator<T>().deallocate(p, size);
+      return;
+    }
+    Slot_ *slot = reinterpret_cast<Slot_ *>(
+        const_cast<typename remove_const<T>::type *>(p));
+    Slot_ *&free_list = free_list_();
+    slot->next_ = free_list;
+    free_list = slot;
+  }
+
+  //  returns the largest supported allocation size
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  //  constructs an object in allocated storage
+  template<class U, class... Args>
+  void construct(U *p, Args &&... args) const {
+    new(const_cast<
+            typename remove_const<U>::type *>(p)) U(std::forward<Args>(args) ...);
+  }
+
+  //  destructs an object in allocated storage
+  template<class U>
+  void destroy(U *p) const {
+    p->~U();
+  }
+
+ private:
+  union Slot_ {
+    Slot_ *next_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type value_;
+  };
+
+  //  free slots of threads that have exited
+  struct Orphans_ {
+    std::mutex mutex_;
+    Slot_ *free_list_;
+  };
+
+  //  gives the thread's free slots to the orphans when the thread exits
+  struct ThreadExit_ {
+    ~ThreadExit_() {
+      Slot_ *&free_list = free_list_();
+      if (!free_list) {
+        return;
+      }
+      Slot_ *last = free_list;
+      while (last->next_) {
+        last = last->next_;
+      }
+      Orphans_ &orphans = orphans_();
+      std::lock_guard<std::mutex> lock(orphans.mutex_);
+      last->next_ = orphans.free_list_;
+      orphans.free_list_ = free_list;
+      free_list = nullptr;
+    }
+  };
+
+  static Slot_ *&free_list_() noexcept {
+    static thread_local Slot_ *free_list = nullptr;
+    return free_list;
+  }
+
+  //  never destroyed, so threads that exit during static destruction can
+  //  still hand over their slots
+  static Orphans_ &orphans_() {
+    static Orphans_ *orphans = new Orphans_();
+    return *orphans;
+  }
+
+  //  takes over the orphaned slots if there are any, else carves a chunk
+  static void refill_(Slot_ *&free_list) {
+    static thread_local ThreadExit_ exit;
+    (void)exit;
+    Orphans_ &orphans = orphans_();
+    {
+      std::lock_guard<std::mutex> lock(orphans.mutex_);
+      free_list = orphans.free_list_;
+      orphans.free_list_ = nullptr;
+    }
+    if (free_list) {
+      return;
+    }
+    Slot_ *chunk = reinterpret_cast<Slot_ *>(
+        ::operator new(sizeof(Slot_) * ChunkSize));
+    for (size_type i = ChunkSize; i > 0; --i) {
+      chunk[i - 1].next_ = free_list;
+      free_list = chunk + i - 1;
+    }
+  }
+};
+
+template<class T, class U, size_t ChunkSize>
+bool operator==(__attribute__((unused)) const PoolAllocator<T, ChunkSize> &target,
+                __attribute__((unused)) const PoolAllocator<U, ChunkSize> &other)
+                noexcept {
+  return true;
+}
+
+template<class T, class U, size_t ChunkSize>
+bool operator!=(const PoolAllocator<T, ChunkSize> &target,
+                const PoolAllocator<U, ChunkSize> &other) noexcept {
+  return !(target == other);
+}
+
+//  Maps blocks of kHugePage bytes and up on huge page boundaries and asks
+//  the kernel to back them with transparent huge pages, so a large vector
+//  needs far fewer TLB entries.  Smaller blocks come from ft::Allocator.
+//  Mapped blocks grow with mremap and can hand their unused tail back with
+//  shrink().
+template<class T>
+class HugePageAllocator {
+ public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T value_type;
+
+  template<class U>
+  struct rebind { typedef HugePageAllocator<U> other; };
+
+  constexpr HugePageAllocator() noexcept = default;
+  ~HugePageAllocator() noexcept = default;
+  template<class U>
+  constexpr explicit HugePageAllocator(__attribute__((unused))
+                                       const HugePageAllocator<U> &other)
+                                       noexcept {};
+
   //  allocates uninitialized storage
   pointer allocate(size_type size,
                    __attribute__((unused)) Allocator<void>::const_pointer hint = nullptr) {
@@ -59,13 +587,425 @@ class Allocator {
       throw ft::length_error("allocator<T>::allocate(size_t n) 'n'"
                              " exceeds maximum supported size");
     }
+    if (!mapped_(size)) {
+      return Allocator<T>().allocate(size);
+    }
     return reinterpret_cast<pointer>(
-        ::operator new(size * sizeof(value_type)));
+        memory_detail::map_huge_pages(span_(size)));
   }
 
-  //  deallocates storage
-  void deallocate(pointer p, size_type) const noexcept {
-    ::operator delete(const_cast<typename remove_const<T>::type *>(p));
+  //  allocates storage whose bytes are all zero; mapped blocks already are
+  pointer allocate_zeroed(size_type size) {
+    if (!mapped_(size)) {
+      return Allocator<T>().allocate_zeroed(size);
+    }
+    return allocate(size);
+  }
+
+  //  deallocates storage; 'size' must be the one passed to allocate
+  void deallocate(pointer p, size_type size) const noexcept {
+    if (!mapped_(size)) {
+      Allocator<T>().deallocate(p, size);
+      return;
+    }
+    memory_detail::unmap_pages(
+        const_cast<typename remove_const<T>::type *>(p), span_(size));
+  }
+
+  //  resizes a mapped block in place; false if it would have to move
+  bool try_expand(pointer p, size_type old_size,
+                  size_type new_size) const noexcept {
+    if (!mapped_(old_size) || !mapped_(new_size) || new_size >= max_size()) {
+      return false;
+    }
+    return span_(old_size) == span_(new_size)
+        || memory_detail::remap_pages(
+            const_cast<typename remove_const<T>::type *>(p),
+            span_(old_size), span_(new_size), false) != nullptr;
+  }
+
+  //  moves a block of trivially copyable objects into one of 'new_size' and
+  //  returns it; the pages of a mapped block are moved, not copied
+  pointer reallocate(pointer p, size_type old_size, size_type new_size) {
+    pointer q = allocate(new_size);
+    void *from = const_cast<typename remove_const<T>::type *>(p);
+    void *to = const_cast<typename remove_const<T>::type *>(q);
+    if (mapped_(old_size) && mapped_(new_size)
+        && memory_detail::move_pages(from, span_(old_size),
+                                     to, span_(new_size))) {
+      return q;
+    }
+    std::memcpy(to, from, std::min(old_size, new_size) * sizeof(value_type));
+    deallocate(p, old_size);
+    return q;
+  }
+
+  //  returns the whole pages past the first 'used' objects of a mapped block
+  //  to the system; the block stays allocated and those pages read back as
+  //  zeros when touched again
+  void shrink(pointer p, size_type size, size_type used) const noexcept {
+    if (!mapped_(size)) {
+      return;
+    }
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t keep = memory_detail::round_up(used * sizeof(value_type),
+                                                page);
+    if (keep < span_(size)) {
+      ::madvise(reinterpret_cast<char *>(
+                    const_cast<typename remove_const<T>::type *>(p)) + keep,
+                span_(size) - keep, MADV_DONTNEED);
+    }
+  }
+
+  //  returns the largest supported allocation size
+  size_type max_size() const noexcept {
+    return (std::numeric_limits<size_type>::max() - memory_detail::kHugePage)
+        / sizeof(value_type);
+  }
+
+  //  constructs an object in allocated storage
+  template<class U, class... Args>
+  void construct(U *p, Args &&... args) const {
+    new(const_cast<
+            typename remove_const<U>::type *>(p)) U(std::forward<Args>(args) ...);
+  }
+
+  //  destructs an object in allocated storage
+  template<class U>
+  void destroy(U *p) const {
+    p->~U();
+  }
+
+ private:
+  static bool mapped_(size_type size) noexcept {
+    return size * sizeof(value_type) >= memory_detail::kHugePage;
+  }
+
+  static size_t span_(size_type size) noexcept {
+    return memory_detail::round_up(size * sizeof(value_type),
+                                   memory_detail::kHugePage);
+  }
+};
+
+template<class T, class U>
+bool operator==(__attribute__((unused)) const HugePageAllocator<T> &target,
+                __attribute__((unused)) const HugePageAllocator<U> &other)
+                noexcept {
+  return true;
+}
+
+template<class T, class U>
+bool operator!=(const HugePageAllocator<T> &target,
+                const HugePageAllocator<U> &other) noexcept {
+  return !(target == other);
+}
+
+//  Aligns every block to 'Alignment' bytes (at least alignof(T)) and rounds
+//  its size up to a multiple of it, so aligned vector loads can run over
+//  the whole block and no cache line is shared with another block.
+template<class T, size_t Alignment = 64>
+class AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "alignment must be a power of two");
+
+ public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T value_type;
+
+  static const size_type alignment
+      = Alignment > alignof(T) ? Alignment : alignof(T);
+
+  template<class U>
+  struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+  constexpr AlignedAllocator() noexcept = default;
+  ~AlignedAllocator() noexcept = default;
+  template<class U>
+  constexpr explicit AlignedAllocator(__attribute__((unused))
+                                      const AlignedAllocator<U, Alignment> &other)
+                                      noexcept {};
+
+  //  allocates uninitialized storage
+  pointer allocate(size_type size,
+                   __attribute__((unused)) Allocator<void>::const_pointer hint = nullptr) {
+    if (size >= max_size()) {
+      throw ft::length_error("allocator<T>::allocate(size_t n) 'n'"
+                             " exceeds maximum supported size");
+    }
+    const size_t bytes = memory_detail::round_up(size * sizeof(value_type),
+                                                 alignment);
+#ifdef __cpp_aligned_new
+    return static_cast<pointer>(memory_detail::new_block(bytes, alignment));
+#else
+    void *p = nullptr;
+    if (::posix_memalign(&p, alignment < sizeof(void *) ? sizeof(void *)
+                                                        : alignment,
+                         bytes) != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>(p);
+#endif
+  }
+
+  //  deallocates storage; 'size' must be the one passed to allocate
+  void deallocate(pointer p, size_type size) const noexcept {
+    void *block = const_cast<typename remove_const<T>::type *>(p);
+#ifdef __cpp_aligned_new
+    memory_detail::delete_block(
+        block, memory_detail::round_up(size * sizeof(value_type), alignment),
+        alignment);
+#else
+    (void)size;
+    std::free(block);
+#endif
+  }
+
+  //  returns the largest supported allocation size
+  size_type max_size() const noexcept {
+    return (std::numeric_limits<size_type>::max() - alignment)
+        / sizeof(value_type);
+  }
+
+  //  constructs an object in allocated storage
+  template<class U, class... Args>
+  void construct(U *p, Args &&... args) const {
+    new(const_cast<
+            typename remove_const<U>::type *>(p)) U(std::forward<Args>(args) ...);
+  }
+
+  //  destructs an object in allocated storage
+  template<class U>
+  void destroy(U *p) const {
+    p->~U();
+  }
+};
+
+template<class T, size_t Alignment>
+const size_t AlignedAllocator<T, Alignment>::alignment;
+
+template<class T, class U, size_t Alignment>
+bool operator==(__attribute__((unused)) const AlignedAllocator<T, Alignment> &target,
+                __attribute__((unused)) const AlignedAllocator<U, Alignment> &other)
+                noexcept {
+  return true;
+}
+
+template<class T, class U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &target,
+                const AlignedAllocator<U, Alignment> &other) noexcept {
+  return !(target == other);
+}
+
+namespace memory_detail {
+
+//  blocks of 16, 32, ... 4096 bytes are cached, larger ones are not
+const size_t kMinCachedBytes = 16;
+const size_t kSizeClasses = 9;
+const size_t kMaxCachedBytes = kMinCachedBytes << (kSizeClasses - 1);
+//  blocks move between a thread and the depot a magazine at a time; a
+//  thread keeps at most two magazines per class and the depot holds at most
+//  kDepotMagazines per class, anything beyond goes back to operator delete
+const size_t kMagazineSize = 32;
+const size_t kDepotMagazines = 64;
+
+struct cached_block {
+  cached_block *next_;
+};
+
+inline size_t size_class(size_t bytes) noexcept {
+  size_t c = 0;
+  for (size_t size = kMinCachedBytes; size < bytes; size <<= 1) {
+    ++c;
+  }
+  return c;
+}
+
+inline void free_blocks(cached_block *block, size_t size_class) noexcept {
+  while (block) {
+    cached_block *next = block->next_;
+    delete_block(block, kMinCachedBytes << size_class, alignof(cached_block));
+    block = next;
+  }
+}
+
+//  full magazines shared by all threads, so blocks freed on one thread can
+//  be reused on another
+class magazine_depot {
+ public:
+  //  false if the depot is full; the caller keeps the magazine then
+  bool put(size_t size_class, cached_block *magazine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<cached_block *> &full = full_[size_class];
+    if (full.size() == kDepotMagazines) {
+      return false;
+    }
+    full.push_back(magazine);
+    return true;
+  }
+
+  //  a chain of kMagazineSize blocks, or nullptr
+  cached_block *take(size_t size_class) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<cached_block *> &full = full_[size_class];
+    if (full.empty()) {
+      return nullptr;
+    }
+    cached_block *magazine = full.back();
+    full.pop_back();
+    return magazine;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<cached_block *> full_[kSizeClasses];
+};
+
+//  never destroyed, so threads that exit during static destruction can
+//  still return their blocks
+inline magazine_depot &depot() {
+  static magazine_depot *depot = new magazine_depot;
+  return *depot;
+}
+
+//  free blocks of one thread, per size class
+class thread_cache {
+ public:
+  thread_cache() noexcept {
+    for (size_t c = 0; c < kSizeClasses; ++c) {
+      lists_[c].head_ = nullptr;
+      lists_[c].count_ = 0;
+    }
+  }
+
+  thread_cache(const thread_cache &) = delete;
+  thread_cache &operator=(const thread_cache &) = delete;
+
+  ~thread_cache() {
+    for (size_t c = 0; c < kSizeClasses; ++c) {
+      while (lists_[c].count_ >= kMagazineSize) {
+        flush_(c);
+      }
+      free_blocks(lists_[c].head_, c);
+    }
+  }
+
+  void *allocate(size_t size_class) {
+    free_list &list = lists_[size_class];
+    if (!list.head_) {
+      list.head_ = depot().take(size_class);
+      if (!list.head_) {
+        return new_block(kMinCachedBytes << size_class, alignof(cached_block));
+      }
+      list.count_ = kMagazineSize;
+    }
+    cached_block *block = list.head_;
+    list.head_ = block->next_;
+    --list.count_;
+    return block;
+  }
+
+  void deallocate(void *p, size_t size_class) noexcept {
+    free_list &list = lists_[size_class];
+    cached_block *block = static_cast<cached_block *>(p);
+    block->next_ = list.head_;
+    list.head_ = block;
+    if (++list.count_ == 2 * kMagazineSize) {
+      flush_(size_class);
+    }
+  }
+
+ private:
+  struct free_list {
+    cached_block *head_;
+    size_t count_;
+  };
+
+  free_list lists_[kSizeClasses];
+
+  //  hands the first kMagazineSize blocks to the depot, or frees them
+  void flush_(size_t size_class) noexcept {
+    free_list &list = lists_[size_class];
+    cached_block *magazine = list.head_;
+    cached_block *last = magazine;
+    for (size_t i = 1; i < kMagazineSize; ++i) {
+      last = last->next_;
+    }
+    list.head_ = last->next_;
+    list.count_ -= kMagazineSize;
+    last->next_ = nullptr;
+    bool kept = false;
+    try {
+      kept = depot().put(size_class, magazine);
+    } catch (...) {
+    }
+    if (!kept) {
+      free_blocks(magazine, size_class);
+    }
+  }
+};
+
+inline thread_cache &local_cache() {
+  static thread_local thread_cache cache;
+  return cache;
+}
+
+}
+
+//  Serves blocks of up to 4 KiB from a per-thread cache with one free list
+//  per power-of-two size class, so list nodes and small vector buffers are
+//  recycled without a lock.  Caches trade whole magazines of blocks with a
+//  shared depot, which also carries blocks freed on other threads back into
+//  use.  Both are bounded; larger blocks, and those of types aligned beyond
+//  what operator new guarantees, go to ft::Allocator.
+template<class T>
+class ThreadCacheAllocator {
+ public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T value_type;
+
+  template<class U>
+  struct rebind { typedef ThreadCacheAllocator<U> other; };
+
+  constexpr ThreadCacheAllocator() noexcept = default;
+  ~ThreadCacheAllocator() noexcept = default;
+  template<class U>
+  constexpr explicit ThreadCacheAllocator(__attribute__((unused))
+                                          const ThreadCacheAllocator<U> &other)
+                                          noexcept {};
+
+  //  allocates uninitialized storage
+  pointer allocate(size_type size,
+                   __attribute__((unused)) Allocator<void>::const_pointer hint = nullptr) {
+    if (size >= max_size()) {
+      throw ft::length_error("allocator<T>::allocate(size_t n) 'n'"
+                             " exceeds maximum supported size");
+    }
+    if (!cached_(size)) {
+      return Allocator<T>().allocate(size);
+    }
+    return static_cast<pointer>(memory_detail::local_cache().allocate(
+        memory_detail::size_class(size * sizeof(value_type))));
+  }
+
+  //  deallocates storage; 'size' must be the one passed to allocate
+  void deallocate(pointer p, size_type size) const noexcept {
+    if (!cached_(size)) {
+      Allocator<T>().deallocate(p, size);
+      return;
+    }
+    memory_detail::local_cache().deallocate(
+        const_cast<typename remove_const<T>::type *>(p),
+        memory_detail::size_class(size * sizeof(value_type)));
   }
 
   //  returns the largest supported allocation size
@@ -77,7 +1017,7 @@ class Allocator {
   template<class U, class... Args>
   void construct(U *p, Args &&... args) const {
     new(const_cast<
-            typename remove_const<T>::type *>(p)) U(std::forward<Args>(args) ...);
+            typename remove_const<U>::type *>(p)) U(std::forward<Args>(args) ...);
   }
 
   //  destructs an object in allocated storage
@@ -85,17 +1025,25 @@ class Allocator {
   void destroy(U *p) const {
     p->~U();
   }
+
+ private:
+  //  cached blocks only have the alignment of plain operator new
+  static bool cached_(size_type size) noexcept {
+    return alignof(value_type) <= alignof(std::max_align_t)
+        && size * sizeof(value_type) <= memory_detail::kMaxCachedBytes;
+  }
 };
 
 template<class T, class U>
-bool operator==(__attribute__((unused)) const Allocator<T> &target,
-                __attribute__((unused)) const Allocator<U> &other) noexcept {
+bool operator==(__attribute__((unused)) const ThreadCacheAllocator<T> &target,
+                __attribute__((unused)) const ThreadCacheAllocator<U> &other)
+                noexcept {
   return true;
 }
 
 template<class T, class U>
-bool operator!=(const Allocator<T> &target,
-                const Allocator<U> &other) noexcept {
-  return !operator==<T, U>(target, other);
+bool operator!=(const ThreadCacheAllocator<T> &target,
+                const ThreadCacheAllocator<U> &other) noexcept {
+  return !(target == other);
 }
 }
@@ -0,0 +1,569 @@
+// -*- C++ -*-
+//===------------------------- memory_resource ----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "memory.h"
+
+//  The C++17 polymorphic memory resources, for the C++11 build: containers
+//  take a pmr::polymorphic_allocator that forwards to whichever resource it
+//  was built with, so an arena or a pool can be chosen at run time without
+//  changing the container type.
+namespace ft {
+namespace pmr {
+
+const size_t kMaxAlign = alignof(std::max_align_t);
+
+class memory_resource {
+ public:
+  virtual ~memory_resource() = default;
+
+  void *allocate(size_t bytes, size_t alignment = kMaxAlign) {
+    return do_allocate(bytes, alignment);
+  }
+
+  void deallocate(void *p, size_t bytes, size_t alignment = kMaxAlign) {
+    do_deallocate(p, bytes, alignment);
+  }
+
+  bool is_equal(const memory_resource &other) const noexcept {
+    return do_is_equal(other);
+  }
+
+ private:
+  virtual void *do_allocate(size_t bytes, size_t alignment) = 0;
+  virtual void do_deallocate(void *p, size_t bytes, size_t alignment) = 0;
+  virtual bool do_is_equal(const memory_resource &other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource &a,
+                       const memory_resource &b) noexcept {
+  return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource &a,
+                       const memory_resource &b) noexcept {
+  return !(a == b);
+}
+
+namespace resource_detail {
+
+const size_t kInitialBufferSize = 1024;
+const size_t kSmallestPoolBlock = 16;
+const size_t kLargestPoolBlock = size_t(1) << 16;
+const size_t kMaxPools = 13;
+const size_t kFirstChunkBlocks = 16;
+const size_t kMaxBlocksPerChunk = size_t(1) << 16;
+
+class new_delete_resource : public memory_resource {
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    return memory_detail::new_block(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    memory_detail::delete_block(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+class null_memory_resource : public memory_resource {
+  void *do_allocate(size_t, size_t) override {
+    throw std::bad_alloc();
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+inline memory_resource *&default_resource() noexcept;
+
+}
+
+//  the global operator new and delete
+inline memory_resource *new_delete_resource() noexcept {
+  static resource_detail::new_delete_resource resource;
+  return &resource;
+}
+
+//  throws std::bad_alloc on every allocation
+inline memory_resource *null_memory_resource() noexcept {
+  static resource_detail::null_memory_resource resource;
+  return &resource;
+}
+
+inline memory_resource *&resource_detail::default_resource() noexcept {
+  static memory_resource *resource = pmr::new_delete_resource();
+  return resource;
+}
+
+inline memory_resource *get_default_resource() noexcept {
+  return resource_detail::default_resource();
+}
+
+//  returns the previous default; nullptr restores new_delete_resource()
+inline memory_resource *set_default_resource(memory_resource *r) noexcept {
+  memory_resource *&resource = resource_detail::default_resource();
+  memory_resource *previous = resource;
+  resource = r ? r : new_delete_resource();
+  return previous;
+}
+
+//  An allocator bound to a memory_resource.  It never propagates: a
+//  container keeps its resource through copy, move and swap, and a copy of
+//  a container uses the default resource.  Elements that take an allocator
+//  are given one for the same resource.
+template<class T>
+class polymorphic_allocator {
+ public:
+  typedef T value_type;
+
+  polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+  polymorphic_allocator(memory_resource *r) noexcept : resource_(r) {}
+  polymorphic_allocator(const polymorphic_allocator &other) = default;
+  template<class U>
+  polymorphic_allocator(const polymorphic_allocator<U> &other) noexcept
+      : resource_(other.resource()) {}
+  polymorphic_allocator &operator=(const polymorphic_allocator &) = delete;
+
+  T *allocate(size_t size) {
+    if (size > max_size()) {
+      throw ft::length_error("polymorphic_allocator<T>::allocate(size_t n)"
+                             " 'n' exceeds maximum supported size");
+    }
+    return static_cast<T *>(
+        resource_->allocate(size * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, size_t size) {
+    resource_->deallocate(p, size * sizeof(T), alignof(T));
+  }
+
+  size_t max_size() const noexcept {
+    return std::numeric_limits<size_t>::max() / sizeof(T);
+  }
+
+  template<class U, class... Args>
+  void construct(U *p, Args &&... args) {
+    construct_(p, uses_allocator_<U, Args...>(), std::forward<Args>(args)...);
+  }
+
+  template<class U>
+  void destroy(U *p) {
+    p->~U();
+  }
+
+  polymorphic_allocator select_on_container_copy_construction() const {
+    return polymorphic_allocator();
+  }
+
+  memory_resource *resource() const noexcept {
+    return resource_;
+  }
+
+ private:
+  //  0: no allocator, 1: allocator_arg_t first, 2: allocator last
+  template<class U, class... Args>
+  using uses_allocator_ = std::integral_constant<int,
+      !std::uses_allocator<U, polymorphic_allocator>::value ? 0
+      : std::is_constructible<U, std::allocator_arg_t,
+                              const polymorphic_allocator &, Args...>::value
+          ? 1
+      : std::is_constructible<U, Args...,
+                              const polymorphic_allocator &>::value ? 2 : 0>;
+
+  template<class U, class... Args>
+  void construct_(U *p, std::integral_constant<int, 0>, Args &&... args) {
+    ::new(static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template<class U, class... Args>
+  void construct_(U *p, std::integral_constant<int, 1>, Args &&... args) {
+    ::new(static_cast<void *>(p))
+        U(std::allocator_arg, *this, std::forward<Args>(args)...);
+  }
+
+  template<class U, class... Args>
+  void construct_(U *p, std::integral_constant<int, 2>, Args &&... args) {
+    ::new(static_cast<void *>(p)) U(std::forward<Args>(args)..., *this);
+  }
+
+  memory_resource *resource_;
+};
+
+template<class T, class U>
+bool operator==(const polymorphic_allocator<T> &a,
+                const polymorphic_allocator<U> &b) noexcept {
+  return *a.resource() == *b.resource();
+}
+
+template<class T, class U>
+bool operator!=(const polymorphic_allocator<T> &a,
+                const polymorphic_allocator<U> &b) noexcept {
+  return !(a == b);
+}
+
+//  Hands out memory by bumping a pointer through buffers of growing size
+//  and frees nothing until release() or destruction, for containers that
+//  are built, used and dropped together.
+class monotonic_buffer_resource : public memory_resource {
+ public:
+  monotonic_buffer_resource() noexcept
+      : monotonic_buffer_resource(get_default_resource()) {}
+  explicit monotonic_buffer_resource(memory_resource *upstream) noexcept
+      : upstream_(upstream), buffer_(nullptr), buffer_size_(0),
+        current_(nullptr), left_(0),
+        next_size_(resource_detail::kInitialBufferSize), chunks_(nullptr) {}
+  explicit monotonic_buffer_resource(size_t initial_size,
+      memory_resource *upstream = get_default_resource()) noexcept
+      : monotonic_buffer_resource(upstream) {
+    if (initial_size > sizeof(Chunk_)) {
+      next_size_ = initial_size;
+    }
+  }
+  //  'buffer' is used first and is not owned
+  monotonic_buffer_resource(void *buffer, size_t size,
+      memory_resource *upstream = get_default_resource()) noexcept
+      : monotonic_buffer_resource(upstream) {
+    buffer_ = buffer;
+    buffer_size_ = size;
+    current_ = static_cast<char *>(buffer);
+    left_ = size;
+    if (size > next_size_) {
+      next_size_ = size * 2;
+    }
+  }
+  monotonic_buffer_resource(const monotonic_buffer_resource &) = delete;
+  monotonic_buffer_resource &operator=(
+      const monotonic_buffer_resource &) = delete;
+  ~monotonic_buffer_resource() override {
+    release();
+  }
+
+  //  hands every buffer back upstream and starts over from the initial one
+  void release() noexcept {
+    while (chunks_) {
+      Chunk_ *next = chunks_->next_;
+      upstream_->deallocate(chunks_, chunks_->size_, kMaxAlign);
+      chunks_ = next;
+    }
+    current_ = static_cast<char *>(buffer_);
+    left_ = buffer_size_;
+  }
+
+  memory_resource *upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+ private:
+  struct Chunk_ {
+    Chunk_ *next_;
+    size_t size_;
+  };
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (!bytes) {
+      bytes = 1;
+    }
+    void *p = align_(bytes, alignment);
+    if (!p) {
+      grow_(bytes + alignment);
+      p = align_(bytes, alignment);
+    }
+    current_ = static_cast<char *>(p) + bytes;
+    left_ -= bytes;
+    return p;
+  }
+
+  void do_deallocate(void *, size_t, size_t) override {}
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  void *align_(size_t bytes, size_t alignment) noexcept {
+    if (!current_) {
+      return nullptr;
+    }
+    void *p = current_;
+    if (!std::align(alignment, bytes, p, left_)) {
+      return nullptr;
+    }
+    current_ = static_cast<char *>(p);
+    return p;
+  }
+
+  void grow_(size_t bytes) {
+    size_t size = next_size_;
+    while (size - sizeof(Chunk_) < bytes) {
+      size *= 2;
+    }
+    Chunk_ *chunk = static_cast<Chunk_ *>(upstream_->allocate(size,
+                                                             kMaxAlign));
+    chunk->next_ = chunks_;
+    chunk->size_ = size;
+    chunks_ = chunk;
+    current_ = reinterpret_cast<char *>(chunk + 1);
+    left_ = size - sizeof(Chunk_);
+    next_size_ = size * 2;
+  }
+
+  memory_resource *upstream_;
+  void *buffer_;
+  size_t buffer_size_;
+  char *current_;
+  size_t left_;
+  size_t next_size_;
+  Chunk_ *chunks_;
+};
+
+struct pool_options {
+  size_t max_blocks_per_chunk = 0;
+  size_t largest_required_pool_block = 0;
+};
+
+//  Keeps one free list per power-of-two block size, carved from chunks that
+//  come from upstream and double in size up to max_blocks_per_chunk blocks.
+//  Larger or over-aligned requests go upstream one by one.  Not thread-safe;
+//  synchronized_pool_resource is.
+class unsynchronized_pool_resource : public memory_resource {
+ public:
+  unsynchronized_pool_resource()
+      : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+  explicit unsynchronized_pool_resource(memory_resource *upstream)
+      : unsynchronized_pool_resource(pool_options(), upstream) {}
+  explicit unsynchronized_pool_resource(const pool_options &options)
+      : unsynchronized_pool_resource(options, get_default_resource()) {}
+  unsynchronized_pool_resource(const pool_options &options,
+                               memory_resource *upstream)
+      : upstream_(upstream), options_(options), pools_(0), large_(nullptr) {
+    size_t &blocks = options_.max_blocks_per_chunk;
+    if (!blocks || blocks > resource_detail::kMaxBlocksPerChunk) {
+      blocks = resource_detail::kMaxBlocksPerChunk;
+    }
+    //  rounded up to a pool's block size
+    size_t &largest = options_.largest_required_pool_block;
+    if (!largest || largest > resource_detail::kLargestPoolBlock) {
+      largest = resource_detail::kLargestPoolBlock;
+    }
+    pools_ = pool_index_(largest) + 1;
+    largest = resource_detail::kSmallestPoolBlock << (pools_ - 1);
+  }
+  unsynchronized_pool_resource(const unsynchronized_pool_resource &) = delete;
+  unsynchronized_pool_resource &operator=(
+      const unsynchronized_pool_resource &) = delete;
+  ~unsynchronized_pool_resource() override {
+    release();
+  }
+
+  //  hands every chunk and large block back upstream
+  void release() noexcept {
+    for (size_t i = 0; i < pools_; ++i) {
+      while (pool_[i].chunks_) {
+        Chunk_ *next = pool_[i].chunks_->next_;
+        upstream_->deallocate(pool_[i].chunks_, pool_[i].chunks_->size_,
+                              kMaxAlign);
+        pool_[i].chunks_ = next;
+      }
+      pool_[i] = Pool_();
+    }
+    while (large_) {
+      Large_ *next = large_->next_;
+      upstream_->deallocate(large_->block_, large_->size_,
+                            large_->alignment_);
+      large_ = next;
+    }
+  }
+
+  memory_resource *upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+  pool_options options() const noexcept {
+    return options_;
+  }
+
+ private:
+  struct Block_ {
+    Block_ *next_;
+  };
+  struct Chunk_ {
+    Chunk_ *next_;
+    size_t size_;
+  };
+  //  kept in front of a large block, at the alignment it was asked for
+  struct Large_ {
+    Large_ *next_;
+    Large_ *prev_;
+    void *block_;
+    size_t size_;
+    size_t alignment_;
+  };
+  struct Pool_ {
+    Block_ *free_ = nullptr;
+    Chunk_ *chunks_ = nullptr;
+    size_t next_blocks_ = resource_detail::kFirstChunkBlocks;
+  };
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (alignment > kMaxAlign
+        || bytes > options_.largest_required_pool_block) {
+      return allocate_large_(bytes, alignment);
+    }
+    Pool_ &pool = pool_[pool_index_(std::max(bytes, alignment))];
+    if (!pool.free_) {
+      refill_(pool, resource_detail::kSmallestPoolBlock << (&pool - pool_));
+    }
+    Block_ *block = pool.free_;
+    pool.free_ = block->next_;
+    return block;
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    if (alignment > kMaxAlign
+        || bytes > options_.largest_required_pool_block) {
+      deallocate_large_(p);
+      return;
+    }
+    Pool_ &pool = pool_[pool_index_(std::max(bytes, alignment))];
+    Block_ *block = static_cast<Block_ *>(p);
+    block->next_ = pool.free_;
+    pool.free_ = block;
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  static size_t pool_index_(size_t bytes) noexcept {
+    size_t i = 0;
+    while ((resource_detail::kSmallestPoolBlock << i) < bytes) {
+      ++i;
+    }
+    return i;
+  }
+
+  void refill_(Pool_ &pool, size_t block_size) {
+    const size_t header = memory_detail::round_up(sizeof(Chunk_), kMaxAlign);
+    const size_t size = header + pool.next_blocks_ * block_size;
+    Chunk_ *chunk = static_cast<Chunk_ *>(upstream_->allocate(size,
+                                                             kMaxAlign));
+    chunk->next_ = pool.chunks_;
+    chunk->size_ = size;
+    pool.chunks_ = chunk;
+    char *first = reinterpret_cast<char *>(chunk) + header;
+    for (size_t i = pool.next_blocks_; i > 0; --i) {
+      Block_ *block = reinterpret_cast<Block_ *>(first + (i - 1) * block_size);
+      block->next_ = pool.free_;
+      pool.free_ = block;
+    }
+    if (pool.next_blocks_ < options_.max_blocks_per_chunk) {
+      pool.next_blocks_ = std::min(pool.next_blocks_ * 2,
+                                   options_.max_blocks_per_chunk);
+    }
+  }
+
+  void *allocate_large_(size_t bytes, size_t alignment) {
+    alignment = std::max(alignment, alignof(Large_));
+    const size_t header = memory_detail::round_up(sizeof(Large_), alignment);
+    const size_t size = header + bytes;
+    char *block = static_cast<char *>(upstream_->allocate(size, alignment));
+    Large_ *large = reinterpret_cast<Large_ *>(block + header) - 1;
+    large->next_ = large_;
+    large->prev_ = nullptr;
+    large->block_ = block;
+    large->size_ = size;
+    large->alignment_ = alignment;
+    if (large_) {
+      large_->prev_ = large;
+    }
+    large_ = large;
+    return block + header;
+  }
+
+  void deallocate_large_(void *p) {
+    Large_ *large = static_cast<Large_ *>(p) - 1;
+    if (large->prev_) {
+      large->prev_->next_ = large->next_;
+    } else {
+      large_ = large->next_;
+    }
+    if (large->next_) {
+      large->next_->prev_ = large->prev_;
+    }
+    upstream_->deallocate(large->block_, large->size_, large->alignment_);
+  }
+
+  memory_resource *upstream_;
+  pool_options options_;
+  Pool_ pool_[resource_detail::kMaxPools];
+  size_t pools_;
+  Large_ *large_;
+};
+
+//  unsynchronized_pool_resource behind a mutex
+class synchronized_pool_resource : public memory_resource {
+ public:
+  synchronized_pool_resource()
+      : synchronized_pool_resource(pool_options(), get_default_resource()) {}
+  explicit synchronized_pool_resource(memory_resource *upstream)
+      : synchronized_pool_resource(pool_options(), upstream) {}
+  explicit synchronized_pool_resource(const pool_options &options)
+      : synchronized_pool_resource(options, get_default_resource()) {}
+  synchronized_pool_resource(const pool_options &options,
+                             memory_resource *upstream)
+      : pool_(options, upstream) {}
+  synchronized_pool_resource(const synchronized_pool_resource &) = delete;
+  synchronized_pool_resource &operator=(
+      const synchronized_pool_resource &) = delete;
+
+  void release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.release();
+  }
+
+  memory_resource *upstream_resource() const noexcept {
+    return pool_.upstream_resource();
+  }
+
+  pool_options options() const noexcept {
+    return pool_.options();
+  }
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::mutex mutex_;
+  unsynchronized_pool_resource pool_;
+};
+
+}
+}
@@ -0,0 +1,211 @@
+// -*- C++ -*-
+//===--------------------------- parallel sort ----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "tools/thread_pool.h"
+#include "vector/vector.h"
+#include "list/list.h"
+
+namespace ft {
+
+namespace parallel_sort_detail {
+
+//  below this many elements one thread sorts faster than the pool starts
+const size_t kMinElements = 1 << 14;
+//  samples taken per bucket when choosing the splitters
+const size_t kOversample = 32;
+//  bucket ids are stored in one byte per element
+const size_t kMaxBuckets = 256;
+
+//  more threads than cores only makes the workers evict each other's cache
+inline size_t usable_threads(size_t threads) {
+  size_t cores = std::thread::hardware_concurrency();
+  return cores != 0 && cores < threads ? cores : threads;
+}
+
+}
+
+//  Samplesort: splitters chosen from an evenly spaced sample cut the vector
+//  into one bucket per thread, the buckets are scattered into a scratch
+//  buffer from the vector's allocator and sorted concurrently.  Not stable.
+//  Types whose move constructor may throw are sorted on the calling thread.
+template<class T, class Alloc, class Guarantee, class Telemetry,
+         class Compare>
+void parallel_sort(ft::vector<T, Alloc, Guarantee, Telemetry> &v,
+                   Compare comp, size_t threads) {
+  using namespace parallel_sort_detail;
+  const size_t n = v.size();
+  T *data = v.data();
+  threads = usable_threads(threads);
+  if (threads <= 1 || n < kMinElements
+      || !std::is_nothrow_move_constructible<T>::value) {
+    std::sort(data, data + n, comp);
+    return;
+  }
+  const size_t buckets = std::min(threads, kMaxBuckets);
+
+  //  the sample and the splitters point into the vector, so the elements
+  //  need not be copyable; they stay in place until every id is known
+  std::vector<const T *> splitters;
+  {
+    std::vector<const T *> sample;
+    const size_t samples = buckets * kOversample;
+    sample.reserve(samples);
+    for (size_t i = 0; i < samples; ++i) {
+      sample.push_back(data + i * (n / samples));
+    }
+    std::sort(sample.begin(), sample.end(),
+              [&comp](const T *a, const T *b) { return comp(*a, *b); });
+    for (size_t i = 1; i < buckets; ++i) {
+      splitters.push_back(sample[i * kOversample]);
+    }
+  }
+
+  thread_pool pool(threads);
+  std::vector<std::future<void> > tasks;
+  std::vector<unsigned char> ids(n);
+  std::vector<std::vector<size_t> > offsets(buckets,
+                                            std::vector<size_t>(buckets));
+  const size_t block = (n + buckets - 1) / buckets;
+
+  for (size_t b = 0; b < buckets; ++b) {
+    tasks.push_back(pool.submit([&, b]() {
+      std::vector<size_t> &count = offsets[b];
+      for (size_t i = b * block; i < std::min(n, (b + 1) * block); ++i) {
+        ids[i] = static_cast<unsigned char>(
+            std::upper_bound(splitters.begin(), splitters.end(), data[i],
+                             [&comp](const T &value, const T *splitter) {
+                               return comp(value, *splitter);
+                             }) - splitters.begin());
+        ++count[ids[i]];
+      }
+    }));
+  }
+  wait_all(tasks);
+
+  //  offsets[block][bucket] becomes where that block writes into the bucket
+  std::vector<size_t> bounds(buckets + 1);
+  for (size_t k = 0, position = 0; k < buckets; ++k) {
+    bounds[k] = position;
+    for (size_t b = 0; b < buckets; ++b) {
+      size_t count = offsets[b][k];
+      offsets[b][k] = position;
+      position += count;
+    }
+  }
+  bounds[buckets] = n;
+
+  typedef std::allocator_traits<Alloc> alloc_traits;
+  Alloc alloc = v.get_allocator();
+  T *scratch = alloc_traits::allocate(alloc, n);
+  for (size_t b = 0; b < buckets; ++b) {
+    tasks.push_back(pool.submit([&, b]() {
+      std::vector<size_t> &position = offsets[b];
+      for (size_t i = b * block; i < std::min(n, (b + 1) * block); ++i) {
+        alloc_traits::construct(alloc, scratch + position[ids[i]]++,
+                                std::move(data[i]));
+      }
+    }));
+  }
+  wait_all(tasks);
+
+  try {
+    for (size_t k = 0; k < buckets; ++k) {
+      tasks.push_back(pool.submit([&, k]() {
+        std::sort(scratch + bounds[k], scratch + bounds[k + 1], comp);
+      }));
+    }
+    wait_all(tasks);
+  } catch (...) {
+    for (size_t i = 0; i < n; ++i) {
+      data[i] = std::move(scratch[i]);
+      alloc_traits::destroy(alloc, scratch + i);
+    }
+    alloc_traits::deallocate(alloc, scratch, n);
+    throw;
+  }
+  for (size_t k = 0; k < buckets; ++k) {
+    tasks.push_back(pool.submit([&, k]() {
+      for (size_t i = bounds[k]; i < bounds[k + 1]; ++i) {
+        data[i] = std::move(scratch[i]);
+        alloc_traits::destroy(alloc, scratch + i);
+      }
+    }));
+  }
+  wait_all(tasks);
+  alloc_traits::deallocate(alloc, scratch, n);
+}
+
+//  Splits the list into one chunk per thread with counted splices, sorts the
+//  chunks concurrently and merges neighbours pairwise, so no node is copied
+//  or allocated.  Stable, like list::sort.
+template<class T, class Alloc, class SizePolicy, class Compare>
+void parallel_sort(ft::list<T, Alloc, SizePolicy> &lst, Compare comp,
+                   size_t threads) {
+  using namespace parallel_sort_detail;
+  typedef ft::list<T, Alloc, SizePolicy> list_type;
+  const size_t n = lst.size();
+  threads = usable_threads(threads);
+  if (threads <= 1 || n < kMinElements) {
+    lst.sort(comp);
+    return;
+  }
+
+  std::vector<list_type> chunks;
+  chunks.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    chunks.emplace_back(lst.get_allocator());
+  }
+  for (size_t i = 0; i < threads; ++i) {
+    size_t count = n / threads + (i < n % threads ? 1 : 0);
+    typename list_type::iterator last = lst.begin();
+    std::advance(last, count);
+    chunks[i].splice(chunks[i].end(), lst, lst.begin(), last, count);
+  }
+
+  thread_pool pool(threads);
+  std::vector<std::future<void> > tasks;
+  try {
+    for (size_t i = 0; i < threads; ++i) {
+      tasks.push_back(pool.submit([&, i]() { chunks[i].sort(comp); }));
+    }
+    wait_all(tasks);
+    for (size_t width = 1; width < threads; width *= 2) {
+      for (size_t i = 0; i + width < threads; i += 2 * width) {
+        tasks.push_back(pool.submit([&, i, width]() {
+          chunks[i].merge(chunks[i + width], comp);
+        }));
+      }
+      wait_all(tasks);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < threads; ++i) {
+      lst.splice(lst.end(), chunks[i]);
+    }
+    throw;
+  }
+  lst.splice(lst.end(), chunks[0]);
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void parallel_sort(ft::vector<T, Alloc, Guarantee, Telemetry> &v,
+                   size_t threads) {
+  parallel_sort(v, std::less<T>(), threads);
+}
+
+template<class T, class Alloc, class SizePolicy>
+void parallel_sort(ft::list<T, Alloc, SizePolicy> &lst, size_t threads) {
+  parallel_sort(lst, std::less<T>(), threads);
+}
+
+}
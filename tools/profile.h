@@ -7,9 +7,23 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <typeinfo>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "tools/memory.h"
+#include "tools/telemetry.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -38,4 +52,407 @@ class LogDuration {
 #define UNIQ_ID(lineno) UNIQ_ID_IMPL(lineno)
 
 #define LOG_DURATION(message) \
-  LogDuration UNIQ_ID(__LINE__){message};
\ No newline at end of file
+  LogDuration UNIQ_ID(__LINE__){message};
+
+namespace ft {
+
+//  Times a scope like LogDuration and also counts, for this thread in user
+//  space, the hardware events that usually explain a difference in time:
+//  cycles, instructions, L1 data and last level cache read misses, branch
+//  misses and dTLB read misses.  The counters come from Linux
+//  perf_event_open; any the kernel or CPU does not offer (other systems,
+//  virtual machines, a strict perf_event_paranoid) are left out of the
+//  report, down to the time alone.
+class PerfScope {
+ public:
+  enum Counter {
+    kCycles,
+    kInstructions,
+    kL1dMisses,
+    kLlcMisses,
+    kBranchMisses,
+    kDtlbMisses,
+    kCounters
+  };
+
+  explicit PerfScope(const string &msg = "", ostream &os = cerr)
+      : message_(msg + ": "), os_(os) {
+    for (int c = 0; c < kCounters; ++c) {
+      fds_[c] = open_counter(static_cast<Counter>(c));
+    }
+    for (int c = 0; c < kCounters; ++c) {
+      control(fds_[c], true);
+    }
+    start_ = steady_clock::now();
+  }
+
+  ~PerfScope() {
+    auto finish = steady_clock::now();
+    for (int c = 0; c < kCounters; ++c) {
+      control(fds_[c], false);
+    }
+    os_ << message_ << duration_cast<nanoseconds>(finish - start_).count()
+        << " ns";
+    for (int c = 0; c < kCounters; ++c) {
+      if (counted(static_cast<Counter>(c))) {
+        os_ << ", " << read(static_cast<Counter>(c)) << ' '
+            << name(static_cast<Counter>(c));
+      }
+    }
+    if (counted(kCycles) && counted(kInstructions) && read(kCycles)) {
+      os_ << ", " << static_cast<double>(read(kInstructions)) / read(kCycles)
+          << " IPC";
+    }
+    os_ << endl;
+#ifdef __linux__
+    for (int c = 0; c < kCounters; ++c) {
+      if (fds_[c] >= 0) {
+        ::close(fds_[c]);
+      }
+    }
+#endif
+  }
+
+  PerfScope(const PerfScope &) = delete;
+  PerfScope &operator=(const PerfScope &) = delete;
+
+  bool available(Counter c) const noexcept { return fds_[c] >= 0; }
+
+  //  false if the counter is not available or has never been scheduled
+  bool counted(Counter c) const noexcept {
+    uint64_t values[3];
+    return read_values(c, values) && values[2];
+  }
+
+  //  events counted so far, scaled up if the kernel had to multiplex the
+  //  counter with others; 0 for one that has not counted
+  uint64_t read(Counter c) const noexcept {
+    uint64_t values[3];
+    if (!read_values(c, values) || !values[2]) {
+      return 0;
+    }
+    if (values[2] < values[1]) {
+      return static_cast<uint64_t>(
+          static_cast<double>(values[0]) * values[1] / values[2]);
+    }
+    return values[0];
+  }
+
+  static const char *name(Counter c) noexcept {
+    static const char *const names[kCounters] = {
+        "cycles", "instructions", "L1d misses", "LLC misses",
+        "branch misses", "dTLB misses"};
+    return names[c];
+  }
+
+ private:
+  static int open_counter(Counter c) noexcept {
+#ifdef __linux__
+    static const uint32_t types[kCounters] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+    //  cache events are id | operation << 8 | result << 16
+    static const uint64_t read_miss = PERF_COUNT_HW_CACHE_OP_READ << 8
+        | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+    static const uint64_t configs[kCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | read_miss,
+        PERF_COUNT_HW_CACHE_LL | read_miss,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB | read_miss};
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = types[c];
+    attr.config = configs[c];
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+                                      0));
+#else
+    (void)c;
+    return -1;
+#endif
+  }
+
+  //  the value, time enabled and time running of a counter
+  bool read_values(Counter c, uint64_t (&values)[3]) const noexcept {
+#ifdef __linux__
+    return fds_[c] >= 0 && ::read(fds_[c], values, sizeof(values))
+        == static_cast<ssize_t>(sizeof(values));
+#else
+    (void)c;
+    (void)values;
+    return false;
+#endif
+  }
+
+  static void control(int fd, bool enable) noexcept {
+#ifdef __linux__
+    if (fd < 0) {
+      return;
+    }
+    if (enable) {
+      ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    }
+    ::ioctl(fd, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+#else
+    (void)fd;
+    (void)enable;
+#endif
+  }
+
+  string message_;
+  ostream &os_;
+  int fds_[kCounters];
+  steady_clock::time_point start_;
+};
+
+}
+
+#define LOG_PERF(message) \
+  ft::PerfScope UNIQ_ID(__LINE__){message};
+
+namespace ft {
+
+//  Allocation counters for one allocator owner: calls, bytes, live and peak
+//  live bytes, and a histogram of request sizes in power-of-two buckets.
+//  Every instance is linked into a registry that report_allocations() walks,
+//  so the counters can be read at any point or dumped at exit.  Updates are
+//  relaxed atomics; the numbers are exact, only their ordering is not.
+class AllocationStats : public telemetry_detail::registered<AllocationStats> {
+ public:
+  static const size_t kBuckets = 48;
+
+  explicit AllocationStats(const std::string &name) : name_(name) {
+    reset();
+  }
+
+  void record_allocate(size_t bytes) noexcept {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    histogram_[bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+    telemetry_detail::raise(peak_bytes_, live_bytes_.fetch_add(
+        bytes, std::memory_order_relaxed) + bytes);
+  }
+
+  void record_deallocate(size_t bytes) noexcept {
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+    live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  //  a live block went from 'old_bytes' to 'new_bytes' where it was; no
+  //  call is counted
+  void record_resize(size_t old_bytes, size_t new_bytes) noexcept {
+    if (new_bytes < old_bytes) {
+      live_bytes_.fetch_sub(old_bytes - new_bytes, std::memory_order_relaxed);
+      return;
+    }
+    const size_t grown = new_bytes - old_bytes;
+    allocated_bytes_.fetch_add(grown, std::memory_order_relaxed);
+    telemetry_detail::raise(peak_bytes_, live_bytes_.fetch_add(
+        grown, std::memory_order_relaxed) + grown);
+  }
+
+  const std::string &name() const noexcept { return name_; }
+  size_t allocations() const noexcept { return allocations_.load(); }
+  size_t deallocations() const noexcept { return deallocations_.load(); }
+  size_t allocated_bytes() const noexcept { return allocated_bytes_.load(); }
+  size_t live_bytes() const noexcept { return live_bytes_.load(); }
+  size_t peak_bytes() const noexcept { return peak_bytes_.load(); }
+
+  //  number of requests of more than 2^(k-1) and at most 2^k bytes
+  size_t histogram(size_t k) const noexcept { return histogram_[k].load(); }
+
+  //  bucket of a request of 'bytes'
+  static size_t bucket(size_t bytes) noexcept {
+    size_t k = 0;
+    while (k + 1 < kBuckets && (size_t(1) << k) < bytes) {
+      ++k;
+    }
+    return k;
+  }
+
+  //  zeroes the counters; blocks still live are forgotten
+  void reset() noexcept {
+    allocations_ = 0;
+    deallocations_ = 0;
+    allocated_bytes_ = 0;
+    live_bytes_ = 0;
+    peak_bytes_ = 0;
+    for (size_t k = 0; k < kBuckets; ++k) {
+      histogram_[k] = 0;
+    }
+  }
+
+  void report(std::ostream &os) const {
+    os << name_ << ": " << allocations() << " allocations, "
+       << deallocations() << " deallocations, "
+       << allocated_bytes() << " bytes, "
+       << live_bytes() << " live, "
+       << peak_bytes() << " peak" << std::endl;
+    for (size_t k = 0; k < kBuckets; ++k) {
+      if (histogram(k)) {
+        os << "  <= " << std::setw(10) << (size_t(1) << k) << " bytes: "
+           << histogram(k) << std::endl;
+      }
+    }
+  }
+
+ private:
+  std::string name_;
+  std::atomic<size_t> allocations_;
+  std::atomic<size_t> deallocations_;
+  std::atomic<size_t> allocated_bytes_;
+  std::atomic<size_t> live_bytes_;
+  std::atomic<size_t> peak_bytes_;
+  std::atomic<size_t> histogram_[kBuckets];
+};
+
+//  writes the report of every live AllocationStats, newest first
+inline void report_allocations(std::ostream &os = std::cerr) {
+  AllocationStats::for_each([&os](const AllocationStats &stats) {
+    stats.report(os);
+  });
+}
+
+//  writes the growth report of every vector call site whose stats exist,
+//  newest first
+inline void report_vector_growth(std::ostream &os = std::cerr) {
+  VectorGrowthStats::for_each([&os](const VectorGrowthStats &stats) {
+    stats.report(os);
+  });
+}
+
+//  the counters shared by every CountingAllocator with this 'Tag'
+template<class Tag>
+AllocationStats &allocation_stats() {
+  static AllocationStats stats(
+      telemetry_detail::demangle(typeid(Tag).name()));
+  return stats;
+}
+
+//  Wraps 'Inner' and records every allocate and deallocate in an
+//  AllocationStats.  By default all allocators with the same 'Tag' share
+//  allocation_stats<Tag>(), so tagging a container type attributes its
+//  memory to it; passing a stats object instead counts one instance alone.
+//  Rebinding keeps the tag and the stats, so list nodes count for the list.
+//  allocate_zeroed, try_expand and reallocate exist when 'Inner' has them,
+//  so wrapping an allocator leaves the containers' fast paths in place.
+template<class T, class Inner = ft::Allocator<T>, class Tag = T>
+class CountingAllocator {
+  typedef std::allocator_traits<Inner> inner_traits;
+
+ public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T value_type;
+  typedef Inner inner_allocator_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  template<class U>
+  struct rebind {
+    typedef CountingAllocator<
+        U, typename inner_traits::template rebind_alloc<U>, Tag> other;
+  };
+
+  CountingAllocator() : inner_(), stats_(&allocation_stats<Tag>()) {}
+  explicit CountingAllocator(AllocationStats *stats,
+                             const Inner &inner = Inner())
+      : inner_(inner), stats_(stats) {}
+  template<class U, class OtherInner>
+  CountingAllocator(const CountingAllocator<U, OtherInner, Tag> &other)
+      : inner_(other.inner()), stats_(other.stats()) {}
+
+  //  allocates uninitialized storage
+  pointer allocate(size_type size) {
+    pointer p = inner_traits::allocate(inner_, size);
+    stats_->record_allocate(size * sizeof(value_type));
+    return p;
+  }
+
+  //  allocates zeroed storage, if 'Inner' can
+  template<class I = Inner>
+  typename std::enable_if<has_allocate_zeroed<I>::value, pointer>::type
+  allocate_zeroed(size_type size) {
+    pointer p = inner_.allocate_zeroed(size);
+    stats_->record_allocate(size * sizeof(value_type));
+    return p;
+  }
+
+  //  deallocates storage; 'size' must be the one passed to allocate
+  void deallocate(pointer p, size_type size) noexcept {
+    stats_->record_deallocate(size * sizeof(value_type));
+    inner_traits::deallocate(inner_, p, size);
+  }
+
+  //  resizes a block in place, if 'Inner' can; the block keeps its count
+  template<class I = Inner>
+  typename std::enable_if<has_try_expand<I>::value, bool>::type
+  try_expand(pointer p, size_type old_size, size_type new_size) noexcept {
+    if (!inner_.try_expand(p, old_size, new_size)) {
+      return false;
+    }
+    stats_->record_resize(old_size * sizeof(value_type),
+                          new_size * sizeof(value_type));
+    return true;
+  }
+
+  //  moves a block into a new one, if 'Inner' can; counted as allocating
+  //  the new block before the old one goes, as a copy would
+  template<class I = Inner>
+  typename std::enable_if<has_reallocate<I>::value, pointer>::type
+  reallocate(pointer p, size_type old_size, size_type new_size) {
+    pointer q = inner_.reallocate(p, old_size, new_size);
+    stats_->record_allocate(new_size * sizeof(value_type));
+    stats_->record_deallocate(old_size * sizeof(value_type));
+    return q;
+  }
+
+  //  returns the largest supported allocation size
+  size_type max_size() const noexcept {
+    return inner_traits::max_size(inner_);
+  }
+
+  //  constructs an object in allocated storage the way 'Inner' would
+  template<class U, class... Args>
+  void construct(U *p, Args &&... args) {
+    inner_traits::construct(inner_, p, std::forward<Args>(args) ...);
+  }
+
+  //  destructs an object in allocated storage the way 'Inner' would
+  template<class U>
+  void destroy(U *p) {
+    inner_traits::destroy(inner_, p);
+  }
+
+  const Inner &inner() const noexcept { return inner_; }
+  AllocationStats *stats() const noexcept { return stats_; }
+
+ private:
+  Inner inner_;
+  AllocationStats *stats_;
+};
+
+//  blocks may only be handed between allocators that count them the same
+template<class T, class U, class InnerT, class InnerU, class Tag>
+bool operator==(const CountingAllocator<T, InnerT, Tag> &target,
+                const CountingAllocator<U, InnerU, Tag> &other) noexcept {
+  return target.stats() == other.stats() && target.inner() == other.inner();
+}
+
+template<class T, class U, class InnerT, class InnerU, class Tag>
+bool operator!=(const CountingAllocator<T, InnerT, Tag> &target,
+                const CountingAllocator<U, InnerU, Tag> &other) noexcept {
+  return !(target == other);
+}
+
+}
@@ -0,0 +1,171 @@
+// -*- C++ -*-
+//===----------------------------- radix sort -----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "vector/vector.h"
+
+namespace ft {
+
+namespace radix_sort_detail {
+
+//  below this many elements a comparison sort wins
+const size_t kMinElements = 64;
+//  from these sizes wider digits pay for their larger histograms; 16-bit
+//  digits only suit 16-bit keys, elsewhere 64K scatter targets thrash the TLB
+const size_t kElevenBitMin = 1 << 16;
+const size_t kSixteenBitMin = 1 << 18;
+
+//  maps a key to an unsigned integer with the same order
+template<class K, bool = std::is_integral<K>::value>
+struct radix_traits {
+  typedef typename std::make_unsigned<K>::type type;
+
+  static type map(K key) {
+    type bits = static_cast<type>(key);
+    return std::is_signed<K>::value
+        ? static_cast<type>(bits ^ (type(1) << (sizeof(type) * 8 - 1)))
+        : bits;
+  }
+};
+
+//  negative floats are ordered by their inverted bits, the rest by setting
+//  the sign bit; -0.0 sorts before 0.0 and NaNs go to the end of their sign
+template<class K, class U>
+struct radix_float_traits {
+  typedef U type;
+
+  static type map(K key) {
+    type bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    const type sign = type(1) << (sizeof(type) * 8 - 1);
+    return bits & sign ? ~bits : bits | sign;
+  }
+};
+
+template<>
+struct radix_traits<float, false> : radix_float_traits<float, uint32_t> {};
+
+template<>
+struct radix_traits<double, false> : radix_float_traits<double, uint64_t> {};
+
+struct identity {
+  template<class K>
+  K operator()(K key) const noexcept {
+    return key;
+  }
+};
+
+inline size_t digit_bits(size_t key_bits, size_t n) {
+  if (key_bits == 16 && n >= kSixteenBitMin) {
+    return 16;
+  }
+  if (key_bits >= 32 && n >= kElevenBitMin) {
+    return 11;
+  }
+  return 8;
+}
+
+}
+
+//  LSD radix sort on key(element), which must be an integral or float/double
+//  value and must not throw.  Stable.  Each pass scatters between the vector
+//  and a scratch buffer from its allocator; passes whose digit is the same
+//  for every element are skipped.  Types whose move may throw are sorted with
+//  std::stable_sort instead.
+template<class T, class Alloc, class Guarantee, class Telemetry, class Key>
+void radix_sort(ft::vector<T, Alloc, Guarantee, Telemetry> &v, Key key) {
+  using namespace radix_sort_detail;
+  typedef typename std::decay<decltype(key(std::declval<const T &>()))>::type
+      key_type;
+  static_assert(std::is_arithmetic<key_type>::value
+                    && !std::is_same<key_type, bool>::value
+                    && !std::is_same<key_type, long double>::value,
+                "radix_sort needs an integral, float or double key");
+  typedef radix_traits<key_type> traits;
+  typedef typename traits::type radix_type;
+
+  const size_t n = v.size();
+  T *data = v.data();
+  if (n < kMinElements
+      || !std::is_nothrow_move_constructible<T>::value
+      || !std::is_nothrow_move_assignable<T>::value) {
+    std::stable_sort(data, data + n, [&key](const T &a, const T &b) {
+      return traits::map(key(a)) < traits::map(key(b));
+    });
+    return;
+  }
+
+  const size_t key_bits = sizeof(radix_type) * 8;
+  const size_t bits = digit_bits(key_bits, n);
+  const size_t passes = (key_bits + bits - 1) / bits;
+  const size_t radix = size_t(1) << bits;
+  const radix_type mask = static_cast<radix_type>(radix - 1);
+
+  std::vector<size_t> counts(passes * radix);
+  for (size_t i = 0; i < n; ++i) {
+    radix_type mapped = traits::map(key(data[i]));
+    for (size_t p = 0; p < passes; ++p) {
+      ++counts[p * radix + ((mapped >> (p * bits)) & mask)];
+    }
+  }
+
+  typedef std::allocator_traits<Alloc> alloc_traits;
+  Alloc alloc = v.get_allocator();
+  T *scratch = nullptr;
+  bool scratch_live = false;
+  T *source = data;
+  for (size_t p = 0; p < passes; ++p) {
+    size_t *count = &counts[p * radix];
+    if (count[(traits::map(key(source[0])) >> (p * bits)) & mask] == n) {
+      continue;
+    }
+    if (!scratch) {
+      scratch = alloc_traits::allocate(alloc, n);
+    }
+    for (size_t d = 0, offset = 0; d < radix; ++d) {
+      size_t c = count[d];
+      count[d] = offset;
+      offset += c;
+    }
+    T *target = source == data ? scratch : data;
+    const size_t shift = p * bits;
+    for (size_t i = 0; i < n; ++i) {
+      T *to = target + count[(traits::map(key(source[i])) >> shift) & mask]++;
+      if (target == scratch && !scratch_live) {
+        alloc_traits::construct(alloc, to, std::move(source[i]));
+      } else {
+        *to = std::move(source[i]);
+      }
+    }
+    scratch_live = true;
+    source = target;
+  }
+  if (!scratch) {
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    if (source == scratch) {
+      data[i] = std::move(scratch[i]);
+    }
+    alloc_traits::destroy(alloc, scratch + i);
+  }
+  alloc_traits::deallocate(alloc, scratch, n);
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void radix_sort(ft::vector<T, Alloc, Guarantee, Telemetry> &v) {
+  radix_sort(v, radix_sort_detail::identity());
+}
+
+}
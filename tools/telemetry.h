@@ -0,0 +1,201 @@
+// -*- C++ -*-
+//===------------------------------ telemetry -----------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace ft {
+
+namespace telemetry_detail {
+
+inline std::string demangle(const char *name) {
+#ifdef __GNUG__
+  int status = 0;
+  char *readable = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && readable) {
+    std::string result(readable);
+    std::free(readable);
+    return result;
+  }
+#endif
+  return name;
+}
+
+//  raises 'peak' to 'value' if it is lower
+inline void raise(std::atomic<size_t> &peak, size_t value) noexcept {
+  size_t current = peak.load(std::memory_order_relaxed);
+  while (value > current && !peak.compare_exchange_weak(
+      current, value, std::memory_order_relaxed)) {
+  }
+}
+
+//  Links every live Stats object into one list, so a report can walk them
+//  all; the newest comes first.
+template<class Stats>
+class registered {
+ public:
+  registered(const registered &) = delete;
+  registered &operator=(const registered &) = delete;
+
+  template<class Function>
+  static void for_each(Function f) {
+    std::lock_guard<std::mutex> lock(mutex());
+    for (registered *s = head(); s; s = s->next_) {
+      f(static_cast<const Stats &>(*s));
+    }
+  }
+
+ protected:
+  registered() : next_(nullptr), prev_(nullptr) {
+    std::lock_guard<std::mutex> lock(mutex());
+    next_ = head();
+    if (next_) {
+      next_->prev_ = this;
+    }
+    head() = this;
+  }
+
+  ~registered() {
+    std::lock_guard<std::mutex> lock(mutex());
+    if (prev_) {
+      prev_->next_ = next_;
+    } else {
+      head() = next_;
+    }
+    if (next_) {
+      next_->prev_ = prev_;
+    }
+  }
+
+ private:
+  static std::mutex &mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static registered *&head() {
+    static registered *head = nullptr;
+    return head;
+  }
+
+  registered *next_;
+  registered *prev_;
+};
+
+}
+
+//  Growth counters shared by the vectors of one call site: reallocations,
+//  elements moved one by one, peak capacity, and the capacity and size of
+//  every vector when it is destroyed, whose ratio tells how oversized they
+//  ended up.
+class VectorGrowthStats
+    : public telemetry_detail::registered<VectorGrowthStats> {
+ public:
+  explicit VectorGrowthStats(const std::string &name) : name_(name) {
+    reset();
+  }
+
+  void record_reallocation(size_t capacity) noexcept {
+    reallocations_.fetch_add(1, std::memory_order_relaxed);
+    telemetry_detail::raise(peak_capacity_, capacity);
+  }
+
+  void record_moves(size_t n) noexcept {
+    moved_.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  void record_release(size_t size, size_t capacity) noexcept {
+    released_.fetch_add(1, std::memory_order_relaxed);
+    released_size_.fetch_add(size, std::memory_order_relaxed);
+    released_capacity_.fetch_add(capacity, std::memory_order_relaxed);
+  }
+
+  const std::string &name() const noexcept { return name_; }
+  size_t reallocations() const noexcept { return reallocations_.load(); }
+  size_t moved() const noexcept { return moved_.load(); }
+  size_t peak_capacity() const noexcept { return peak_capacity_.load(); }
+  size_t released() const noexcept { return released_.load(); }
+
+  //  total capacity over total size of the destroyed vectors; 0 if none
+  //  held an element
+  double capacity_ratio() const noexcept {
+    size_t size = released_size_.load();
+    return size ? static_cast<double>(released_capacity_.load()) / size : 0;
+  }
+
+  void reset() noexcept {
+    reallocations_ = 0;
+    moved_ = 0;
+    peak_capacity_ = 0;
+    released_ = 0;
+    released_size_ = 0;
+    released_capacity_ = 0;
+  }
+
+  void report(std::ostream &os) const {
+    os << name_ << ": " << reallocations() << " reallocations, "
+       << moved() << " elements moved, "
+       << peak_capacity() << " peak capacity, "
+       << capacity_ratio() << " capacity/size over "
+       << released() << " vectors" << std::endl;
+  }
+
+ private:
+  std::string name_;
+  std::atomic<size_t> reallocations_;
+  std::atomic<size_t> moved_;
+  std::atomic<size_t> peak_capacity_;
+  std::atomic<size_t> released_;
+  std::atomic<size_t> released_size_;
+  std::atomic<size_t> released_capacity_;
+};
+
+//  Telemetry policies for ft::vector.  The vector calls them whenever its
+//  storage changes; the default one does nothing and compiles away.
+struct vector_no_telemetry {
+  static void reallocated(size_t) noexcept {}
+  static void moved(size_t) noexcept {}
+  static void released(size_t, size_t) noexcept {}
+};
+
+//  Counts into the VectorGrowthStats of 'Tag', one tag per call site.  With
+//  'Record' false the hooks do nothing and compile away, so a call site can
+//  be switched off by its type alone; both share the stats of 'Tag'.
+template<class Tag, bool Record = true>
+struct vector_telemetry {
+  static VectorGrowthStats &stats() {
+    static VectorGrowthStats stats(
+        telemetry_detail::demangle(typeid(Tag).name()));
+    return stats;
+  }
+
+  static void reallocated(size_t capacity) noexcept {
+    if (Record) {
+      stats().record_reallocation(capacity);
+    }
+  }
+
+  static void moved(size_t n) noexcept {
+    if (Record) {
+      stats().record_moves(n);
+    }
+  }
+
+  static void released(size_t size, size_t capacity) noexcept {
+    if (Record) {
+      stats().record_release(size, capacity);
+    }
+  }
+};
+
+}
@@ -0,0 +1,115 @@
+// -*- C++ -*-
+//===--------------------------- thread pool ------------------------------===//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ft {
+
+//  Fixed set of worker threads taking tasks from one queue.  The destructor
+//  finishes the queued tasks and joins the workers.
+class thread_pool {
+ public:
+  explicit thread_pool(size_t threads) : stop_(false) {
+    if (threads == 0) {
+      threads = 1;
+    }
+    workers_.reserve(threads);
+    try {
+      for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(&thread_pool::work_, this);
+      }
+    } catch (...) {
+      shutdown_();
+      throw;
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    shutdown_();
+  }
+
+  //  queues 'task'; the future rethrows whatever the task threw
+  template<class Task>
+  std::future<void> submit(Task task) {
+    std::shared_ptr<std::packaged_task<void()> > packaged
+        = std::make_shared<std::packaged_task<void()> >(std::move(task));
+    std::future<void> result = packaged->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back([packaged]() { (*packaged)(); });
+    }
+    ready_.notify_one();
+    return result;
+  }
+
+  size_t size() const noexcept {
+    return workers_.size();
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()> > tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stop_;
+
+  void work_() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  void shutdown_() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_.notify_all();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i].join();
+    }
+  }
+};
+
+//  waits for every future, then rethrows the first exception among them
+inline void wait_all(std::vector<std::future<void> > &futures) {
+  std::exception_ptr error;
+  for (size_t i = 0; i < futures.size(); ++i) {
+    try {
+      futures[i].get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  futures.clear();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}
@@ -17,22 +17,37 @@ class A {
   A& operator=(A&& other) noexcept;
   ~A();
   int GetCount() const;
+  // operations on every A since the last ResetCounters()
+  static int Constructions();
+  static int Copies();
+  static int Moves();
+  static void ResetCounters();
  private:
   int   count_;
   char* storage_;
+  static int constructions_;
+  static int copies_;
+  static int moves_;
 };
 
+int A::constructions_ = 0;
+int A::copies_ = 0;
+int A::moves_ = 0;
+
 A::A() {
+  ++constructions_;
   count_ = 10;
   storage_ = new char(count_);
 }
 
 A::A(int count) {
+  ++constructions_;
   count_ = count;
   storage_ = new char(count_);
 }
 
 A::A(const A& x){
+  ++copies_;
   count_ = x.count_;
   storage_ = new char(count_);
 }
@@ -41,6 +56,7 @@ A &A::operator=(const A& other) {
   if (this == &other) {
     return *this;
   }
+  ++copies_;
   char* new_storage = new char(other.count_);
   delete storage_;
   storage_ = new_storage;
@@ -49,6 +65,7 @@ A &A::operator=(const A& other) {
 }
 
 A &A::operator=(A &&other) noexcept {
+  ++moves_;
   delete storage_;
   count_ = other.count_;
   storage_ = other.storage_;
@@ -58,6 +75,7 @@ A &A::operator=(A &&other) noexcept {
 }
 
 A::A(A &&other) noexcept {
+  ++moves_;
   count_ = other.count_;
   storage_ = other.storage_;
   other.count_ = 0;
@@ -72,6 +90,22 @@ int A::GetCount() const {
   return count_;
 }
 
+int A::Constructions() {
+  return constructions_;
+}
+
+int A::Copies() {
+  return copies_;
+}
+
+int A::Moves() {
+  return moves_;
+}
+
+void A::ResetCounters() {
+  constructions_ = copies_ = moves_ = 0;
+}
+
 bool operator==(const A& a, const A& b) {
   return a.GetCount() == b.GetCount();
 }
\ No newline at end of file
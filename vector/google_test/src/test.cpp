@@ -7,10 +7,16 @@
 
 #include <vector>
 #include <list>
+#include <random>
+#include <sstream>
+#include <iterator>
+#include <memory_resource>
 #include "gtest/gtest.h"
 #include "includes/A.h"
 //Your include
 #include "vector/vector.h"
+#include "tools/radix_sort.h"
+#include "tools/profile.h"
 
 /*
  * RUN TEST:
@@ -24,10 +30,13 @@
  * copy_constructor
  * move_constructor
  * initializer_list_constructor
+ * const_elements
  * iterator_constructor
+ * input_iterators
  * assign_value
  * assign_range
  * assign_initializer_list
+ * assign_guarantee
  * at
  * back
  * front
@@ -36,6 +45,7 @@
  * clear
  * data
  * emplace
+ * emplace_operations
  * empty
  * end
  * erase
@@ -53,12 +63,23 @@
  * rbegin
  * rend
  * reserve
+ * reserve_relocate
+ * huge_page_allocator
+ * aligned_allocator
+ * polymorphic_allocator
+ * allocator_propagation
+ * counting_allocator
+ * perf_scope
+ * growth_telemetry
  * resize
  * resize_value
+ * resize_default_init
  * shrink_to_fit
  * size
  * swap
  * emplace_back
+ * append
+ * radix_sort
  * iter
  * const_iter
  * relational_operators
@@ -270,6 +291,23 @@ TEST(vector, initializer_list_constructor) {
 }
 // -----------------------------------------------------------------------------
 
+// ---Const elements only need what builds, copies and reads the vector; it-----
+// ---compiles without a std::vector<const T> to compare against.---------------
+TEST(vector, const_elements) {
+  const int values[] = {1, 2, 43, 4};
+  my::vector_<const int> my_vector = {1, 2, 43, 4};
+  EXPECT_TRUE(std::equal(my_vector.begin(), my_vector.end(), values));
+  my::vector_<const int> my_range(my_vector.rbegin(), my_vector.rend());
+  EXPECT_TRUE(std::equal(my_range.rbegin(), my_range.rend(), values));
+  my::vector_<const int> my_copy(my_vector);
+  my::vector_<const int> my_moved(std::move(my_copy));
+  EXPECT_EQ(my_moved, my_vector);
+  my::vector_<const int> my_filled(3, 7);
+  EXPECT_EQ(my_filled.size(), 3u);
+  EXPECT_EQ(my_filled.back(), 7);
+}
+// -----------------------------------------------------------------------------
+
 // ---Create a vector consisting of copies of the elements from [first,last-----
 template<class T>
 void iterator_constructor(int count, const T value) {
@@ -354,6 +392,47 @@ TEST(vector, iterator_constructor) {
     EXPECT_EQ(ex.what(),std::string("vector"));
   }
 }
+
+// ------Builds, assigns and inserts from single-pass input iterators.----------
+TEST(vector, input_iterators) {
+  std::string numbers = "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17";
+  {
+    std::istringstream stl_input(numbers);
+    std::istringstream my_input(numbers);
+    stl::_vector<int> stl_vector((std::istream_iterator<int>(stl_input)),
+                                 std::istream_iterator<int>());
+    my::vector_<int> my_vector((std::istream_iterator<int>(my_input)),
+                               std::istream_iterator<int>());
+    EXPECT_EQ(my_vector.size(), stl_vector.size());
+    EXPECT_TRUE(std::equal(stl_vector.begin(), stl_vector.end(),
+                           my_vector.data()));
+  }
+  for (size_t size : {0, 5, 17, 40}) {
+    stl::_vector<std::string> stl_vector(size, "old");
+    my::vector_<std::string> my_vector(size, "old");
+    std::istringstream stl_input(numbers);
+    std::istringstream my_input(numbers);
+    stl_vector.assign(std::istream_iterator<std::string>(stl_input),
+                      std::istream_iterator<std::string>());
+    my_vector.assign(std::istream_iterator<std::string>(my_input),
+                     std::istream_iterator<std::string>());
+    EXPECT_EQ(my_vector.size(), stl_vector.size());
+    EXPECT_TRUE(std::equal(stl_vector.begin(), stl_vector.end(),
+                           my_vector.data()));
+    std::istringstream stl_more(numbers);
+    std::istringstream my_more(numbers);
+    auto stl_iter = stl_vector.insert(stl_vector.begin() + 3,
+        std::istream_iterator<std::string>(stl_more),
+        std::istream_iterator<std::string>());
+    auto my_iter = my_vector.insert(my_vector.begin() + 3,
+        std::istream_iterator<std::string>(my_more),
+        std::istream_iterator<std::string>());
+    EXPECT_EQ(my_iter - my_vector.begin(), stl_iter - stl_vector.begin());
+    EXPECT_EQ(my_vector.size(), stl_vector.size());
+    EXPECT_TRUE(std::equal(stl_vector.begin(), stl_vector.end(),
+                           my_vector.data()));
+  }
+}
 // -----------------------------------------------------------------------------
 
 // =============================================================================
@@ -570,6 +649,74 @@ TEST(vector, assign_initializer_list) {
 }
 // -----------------------------------------------------------------------------
 
+// ----------Overwrites in place, keeping a backup only for the strong policy.---
+struct throw_on_copy {
+  static int countdown;
+  int value;
+  throw_on_copy(int v) : value(v) {}
+  throw_on_copy(const throw_on_copy &x) : value(x.value) {
+    if (countdown > 0 && --countdown == 0) {
+      throw std::runtime_error("copy");
+    }
+  }
+  throw_on_copy &operator=(const throw_on_copy &x) {
+    if (countdown > 0 && --countdown == 0) {
+      throw std::runtime_error("copy");
+    }
+    value = x.value;
+    return *this;
+  }
+};
+int throw_on_copy::countdown = 0;
+
+TEST(vector, assign_guarantee) {
+  typedef my::vector_<throw_on_copy, ft::Allocator<throw_on_copy>,
+                      ft::vector_basic_guarantee> basic_vector;
+  std::vector<throw_on_copy> source(8, 7);
+  {
+    my::vector_<throw_on_copy> my_vector(10, 1);
+    throw_on_copy::countdown = 4;
+    EXPECT_THROW(my_vector.assign(source.begin(), source.end()),
+                 std::runtime_error);
+    EXPECT_EQ(my_vector.size(), 10u);
+    for (size_t i = 0; i < my_vector.size(); ++i) {
+      EXPECT_EQ(my_vector[i].value, 1);
+    }
+  }
+  {
+    basic_vector my_vector(10, 1);
+    throw_on_copy::countdown = 4;
+    EXPECT_THROW(my_vector.assign(source.begin(), source.end()),
+                 std::runtime_error);
+    EXPECT_EQ(my_vector.capacity(), 10u);
+    EXPECT_LE(my_vector.size(), 10u);
+    throw_on_copy::countdown = 0;
+    my_vector.assign(source.begin(), source.end());
+    my_vector.insert(my_vector.begin() + 1, source.begin(), source.begin() + 2);
+    my_vector.assign(3, throw_on_copy(5));
+    EXPECT_EQ(my_vector.size(), 3u);
+    EXPECT_EQ(my_vector.capacity(), 10u);
+    EXPECT_EQ(my_vector[2].value, 5);
+  }
+  {
+    stl::_vector<std::string> stl_vector(20, "old");
+    my::vector_<std::string, ft::Allocator<std::string>,
+                ft::vector_basic_guarantee> my_vector(20, "old");
+    std::list<std::string> lst(5, "new");
+    stl_vector.assign(lst.begin(), lst.end());
+    my_vector.assign(lst.begin(), lst.end());
+    stl_vector.insert(stl_vector.begin() + 2, lst.begin(), lst.end());
+    my_vector.insert(my_vector.begin() + 2, lst.begin(), lst.end());
+    stl_vector.assign(15, "x");
+    my_vector.assign(15, "x");
+    EXPECT_EQ(my_vector.size(), stl_vector.size());
+    EXPECT_EQ(my_vector.capacity(), stl_vector.capacity());
+    EXPECT_TRUE(std::equal(stl_vector.begin(), stl_vector.end(),
+                           my_vector.data()));
+  }
+}
+// -----------------------------------------------------------------------------
+
 // ================================ AT =========================================
 
 // --------------Provides access to the data contained in the vector.-----------
@@ -848,6 +995,37 @@ TEST(vector, emplace) {
   emplace<char>(4, 'c');
   emplace<std::string>(std::string("vector"), "vec");
 }
+
+// -----Mid-vector emplace and insert(pos, T&&) never copy an element.---------
+TEST(vector, emplace_operations) {
+  my::vector_<A> my_vector;
+  my_vector.reserve(20);
+  for (int i = 0; i < 10; ++i) {
+    my_vector.emplace_back(i);
+  }
+  A::ResetCounters();
+  my_vector.emplace(my_vector.begin() + 4, 42);
+  EXPECT_EQ(A::Constructions(), 1);
+  EXPECT_EQ(A::Copies(), 0);
+  // one for the new last element, five shifted, one into the slot
+  EXPECT_EQ(A::Moves(), 7);
+  EXPECT_EQ(my_vector[4].GetCount(), 42);
+  A value(7);
+  A::ResetCounters();
+  my_vector.insert(my_vector.begin() + 2, std::move(value));
+  EXPECT_EQ(A::Constructions(), 0);
+  EXPECT_EQ(A::Copies(), 0);
+  EXPECT_EQ(A::Moves(), 10);
+  EXPECT_EQ(my_vector[2].GetCount(), 7);
+  EXPECT_EQ(my_vector[5].GetCount(), 42);
+  EXPECT_EQ(my_vector.size(), 12u);
+  // an argument that aliases an element being shifted
+  A::ResetCounters();
+  my_vector.emplace(my_vector.begin(), my_vector[5]);
+  EXPECT_EQ(A::Copies(), 1);
+  EXPECT_EQ(my_vector[0].GetCount(), 42);
+  EXPECT_EQ(my_vector[6].GetCount(), 42);
+}
 // -----------------------------------------------------------------------------
 
 // ============================== EMPTY ========================================
@@ -1615,6 +1793,476 @@ TEST(vector, reserve) {
 }
 // -----------------------------------------------------------------------------
 
+// ----Large trivially copyable vectors relocate keeping values; zeroed ones----
+// ----grow by remapping.-------------------------------------------------------
+TEST(vector, reserve_relocate) {
+  const int size = 1 << 20;
+  my::vector_<int> my_vector;
+  for (int i = 0; i < size; ++i) {
+    my_vector.push_back(i);
+  }
+  my_vector.reserve(3 * size);
+  EXPECT_EQ(my_vector.capacity(), static_cast<size_t>(3 * size));
+  my_vector.resize(4 * size);
+  my_vector.insert(my_vector.begin() + 1, 2 * size, my_vector[5]);
+  ASSERT_EQ(my_vector.size(), static_cast<size_t>(6 * size));
+  EXPECT_EQ(my_vector[0], 0);
+  EXPECT_EQ(my_vector[1], 5);
+  EXPECT_EQ(my_vector[2 * size], 5);
+  EXPECT_EQ(my_vector[2 * size + 1], 1);
+  EXPECT_EQ(my_vector[3 * size - 1], size - 1);
+  EXPECT_EQ(my_vector[6 * size - 1], 0);
+  // a range of the vector itself
+  my_vector.resize(size);
+  for (int i = 0; i < size; ++i) {
+    my_vector[i] = i;
+  }
+  my_vector.shrink_to_fit();
+  my_vector.append(my_vector.begin(), my_vector.end());
+  my_vector.insert(my_vector.end(), my_vector.rbegin(), my_vector.rend());
+  ASSERT_EQ(my_vector.size(), static_cast<size_t>(4 * size));
+  EXPECT_EQ(my_vector[size + 7], 7);
+  EXPECT_EQ(my_vector[2 * size], size - 1);
+  EXPECT_EQ(my_vector[2 * size + 1], size - 2);
+  EXPECT_EQ(my_vector[4 * size - 1], 0);
+  // only zeroed storage is mapped, so only it can grow in place
+  ft::Allocator<int> alloc;
+  int *p = alloc.allocate(size);
+  EXPECT_FALSE(alloc.try_expand(p, size, 2 * size));
+  alloc.deallocate(p, size);
+  my::vector_<int> zero_vector(size);
+  zero_vector[size - 1] = 1;
+  zero_vector.reserve(3 * size);
+  zero_vector.resize(2 * size);
+  EXPECT_EQ(std::count(zero_vector.begin(), zero_vector.end(), 0),
+            2 * size - 1);
+  EXPECT_EQ(zero_vector[size - 1], 1);
+}
+// -----------------------------------------------------------------------------
+
+// ----Small and huge-page-mapped storage behave like any other.----------------
+TEST(vector, huge_page_allocator) {
+  typedef ft::HugePageAllocator<long> allocator;
+  const long size = 1 << 20;
+  my::vector_<long, allocator> my_vector(10, 3);
+  for (long i = 0; i < size; ++i) {
+    my_vector.push_back(i);
+  }
+  ASSERT_EQ(my_vector.size(), static_cast<size_t>(size + 10));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(my_vector.data()) % (1 << 21), 0u);
+  EXPECT_EQ(my_vector[9], 3);
+  EXPECT_EQ(my_vector[size + 9], size - 1);
+  my_vector.insert(my_vector.begin(), 4 * size, 7);
+  EXPECT_EQ(my_vector[4 * size + 10], 0);
+  my::vector_<long, allocator> copy_vector(my_vector);
+  EXPECT_TRUE(std::equal(my_vector.begin(), my_vector.end(),
+                         copy_vector.begin(), copy_vector.end()));
+  // the tail pages come back as zeros
+  my_vector.resize(size);
+  allocator alloc = my_vector.get_allocator();
+  alloc.shrink(my_vector.data(), my_vector.capacity(), my_vector.size());
+  EXPECT_EQ(my_vector[size - 1], 7);
+  EXPECT_EQ(my_vector.data()[my_vector.capacity() - 1], 0);
+  my::vector_<long, allocator> zero_vector(size);
+  EXPECT_EQ(std::count(zero_vector.begin(), zero_vector.end(), 0L), size);
+}
+// -----------------------------------------------------------------------------
+
+// ----Storage stays aligned through growth; aligned_data() is data().---------
+TEST(vector, aligned_allocator) {
+  typedef my::vector_<float, ft::AlignedAllocator<float, 64> > aligned_vector;
+  EXPECT_EQ(aligned_vector::data_alignment, 64u);
+  EXPECT_EQ(my::vector_<double>::data_alignment, alignof(double));
+  aligned_vector my_vector;
+  for (int i = 0; i < 1000; ++i) {
+    my_vector.push_back(static_cast<float>(i));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(my_vector.data()) % 64, 0u);
+  }
+  EXPECT_EQ(my_vector.aligned_data(), my_vector.data());
+  float sum = 0;
+  const float *data = my_vector.aligned_data();
+  for (size_t i = 0; i < my_vector.size(); ++i) {
+    sum += data[i];
+  }
+  EXPECT_EQ(sum, 499500.0f);
+  my_vector.insert(my_vector.begin() + 3, 17, 1.5f);
+  my_vector.shrink_to_fit();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(my_vector.data()) % 64, 0u);
+  EXPECT_EQ(my_vector[19], 1.5f);
+  EXPECT_EQ(my_vector[20], 3.0f);
+  my::vector_<std::string, ft::AlignedAllocator<std::string, 128> >
+      strings(5, "value");
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(strings.data()) % 128, 0u);
+  EXPECT_EQ(strings[4], "value");
+}
+// -----------------------------------------------------------------------------
+
+// ----------------------POLYMORPHIC ALLOCATOR----------------------------------
+// Counts the bytes it passes on to new_delete_resource().
+class counting_resource : public ft::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  long live_bytes = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    live_bytes += bytes;
+    return ft::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    live_bytes -= bytes;
+    ft::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(
+      const ft::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(vector, polymorphic_allocator) {
+  counting_resource counter;
+  {
+    ft::pmr::monotonic_buffer_resource arena(&counter);
+    my::pmr::vector<int> my_vector(&arena);
+    stl::_vector<int> stl_vector;
+    for (int i = 0; i < 1000; ++i) {
+      my_vector.push_back(i);
+      stl_vector.push_back(i);
+    }
+    my_vector.insert(my_vector.begin() + 10, 5, -1);
+    stl_vector.insert(stl_vector.begin() + 10, 5, -1);
+    EXPECT_TRUE(std::equal(my_vector.begin(), my_vector.end(),
+                           stl_vector.begin(), stl_vector.end()));
+    EXPECT_GT(counter.allocations, 0u);
+    // a copy takes the default resource
+    my::pmr::vector<int> copy(my_vector);
+    EXPECT_EQ(copy.get_allocator().resource(),
+              ft::pmr::get_default_resource());
+    EXPECT_EQ(copy, my_vector);
+    // elements that take an allocator get the vector's resource
+    my::pmr::vector<my::pmr::vector<int> > nested(&arena);
+    for (int i = 0; i < 20; ++i) {
+      nested.emplace_back(3, i);
+    }
+    EXPECT_EQ(nested[0].get_allocator().resource(), &arena);
+    EXPECT_EQ(nested[19].get_allocator().resource(), &arena);
+    EXPECT_EQ(nested[19][2], 19);
+    // the resource stays with the vector on assignment and swap
+    my::pmr::vector<int> other(&counter);
+    other = my_vector;
+    EXPECT_EQ(other.get_allocator().resource(), &counter);
+    other = std::move(copy);
+    EXPECT_EQ(other.get_allocator().resource(), &counter);
+    EXPECT_EQ(other, my_vector);
+  }
+  EXPECT_EQ(counter.live_bytes, 0);
+  {
+    ft::pmr::unsynchronized_pool_resource pool(&counter);
+    my::pmr::vector<std::string> strings(&pool);
+    for (int i = 0; i < 300; ++i) {
+      strings.push_back(std::to_string(i));
+    }
+    strings.erase(strings.begin(), strings.begin() + 100);
+    strings.shrink_to_fit();
+    EXPECT_EQ(strings.size(), 200u);
+    EXPECT_EQ(strings.front(), "100");
+    my::pmr::vector<std::string> moved(std::move(strings), &pool);
+    EXPECT_EQ(moved.back(), "299");
+    EXPECT_TRUE(strings.empty());
+    my::pmr::vector<std::string> elsewhere(std::move(moved), &counter);
+    EXPECT_EQ(elsewhere.size(), 200u);
+    EXPECT_EQ(elsewhere.get_allocator().resource(), &counter);
+  }
+  EXPECT_EQ(counter.live_bytes, 0);
+  {
+    std::pmr::monotonic_buffer_resource arena;
+    my::vector_<long, std::pmr::polymorphic_allocator<long> > my_vector(
+        &arena);
+    for (long i = 0; i < 500; ++i) {
+      my_vector.push_back(i * i);
+    }
+    my_vector.resize(600, 7);
+    EXPECT_EQ(my_vector[499], 499L * 499L);
+    EXPECT_EQ(my_vector[599], 7);
+    EXPECT_EQ(my_vector.get_allocator().resource(), &arena);
+  }
+}
+// -----------------------------------------------------------------------------
+
+// ----------------------ALLOCATOR PROPAGATION----------------------------------
+// Only what allocator_traits can't fill in.  Allocators that share a counter
+// compare equal; the counter holds the bytes they have out.
+template<class T, class Propagate = std::true_type>
+struct minimal_allocator {
+  typedef T value_type;
+  typedef Propagate propagate_on_container_copy_assignment;
+  typedef Propagate propagate_on_container_move_assignment;
+  typedef Propagate propagate_on_container_swap;
+
+  explicit minimal_allocator(long *live) : live_(live) {}
+  template<class U>
+  minimal_allocator(const minimal_allocator<U, Propagate> &other)
+      : live_(other.live_) {}
+  T *allocate(size_t n) {
+    *live_ += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) {
+    *live_ -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  long *live_;
+};
+
+template<class T, class U, class P>
+bool operator==(const minimal_allocator<T, P> &a,
+                const minimal_allocator<U, P> &b) {
+  return a.live_ == b.live_;
+}
+
+template<class T, class U, class P>
+bool operator!=(const minimal_allocator<T, P> &a,
+                const minimal_allocator<U, P> &b) {
+  return !(a == b);
+}
+
+TEST(vector, allocator_propagation) {
+  long live_1 = 0;
+  long live_2 = 0;
+  {
+    typedef minimal_allocator<std::string> alloc;
+    const alloc alloc_1(&live_1);
+    const alloc alloc_2(&live_2);
+    my::vector_<std::string, alloc> my_vector_1(alloc_1);
+    my::vector_<std::string, alloc> my_vector_2(alloc_2);
+    for (int i = 0; i < 50; ++i) {
+      my_vector_1.push_back(std::to_string(i));
+    }
+    my_vector_1.insert(my_vector_1.begin(), 3, "x");
+    my_vector_1.erase(my_vector_1.begin() + 1);
+    my_vector_2.push_back("y");
+    my_vector_2 = my_vector_1;
+    EXPECT_EQ(my_vector_2.get_allocator(), alloc_1);
+    EXPECT_EQ(live_2, 0);
+    EXPECT_EQ(my_vector_2, my_vector_1);
+    my::vector_<std::string, alloc> my_vector_3(alloc_2);
+    my_vector_3.push_back("z");
+    my_vector_3 = std::move(my_vector_2);
+    EXPECT_EQ(my_vector_3.get_allocator(), alloc_1);
+    EXPECT_EQ(live_2, 0);
+    my_vector_2 = my::vector_<std::string, alloc>(3, "w", alloc_2);
+    my_vector_2.swap(my_vector_3);
+    EXPECT_EQ(my_vector_2.get_allocator(), alloc_1);
+    EXPECT_EQ(my_vector_3.get_allocator(), alloc_2);
+    EXPECT_EQ(my_vector_3.size(), 3u);
+    EXPECT_EQ(my_vector_2.size(), 52u);
+  }
+  EXPECT_EQ(live_1, 0);
+  EXPECT_EQ(live_2, 0);
+  {
+    typedef minimal_allocator<std::string, std::false_type> alloc;
+    const alloc alloc_1(&live_1);
+    const alloc alloc_2(&live_2);
+    my::vector_<std::string, alloc> my_vector_1(5, "a", alloc_1);
+    my::vector_<std::string, alloc> my_vector_2(alloc_2);
+    my_vector_2 = my_vector_1;
+    EXPECT_EQ(my_vector_2.get_allocator(), alloc_2);
+    EXPECT_GT(live_2, 0);
+    my_vector_1.push_back("b");
+    my_vector_2 = std::move(my_vector_1);
+    EXPECT_EQ(my_vector_2.get_allocator(), alloc_2);
+    EXPECT_EQ(my_vector_2.size(), 6u);
+    EXPECT_EQ(my_vector_2.back(), "b");
+    my::vector_<std::string, alloc> copy(my_vector_2);
+    EXPECT_EQ(copy.get_allocator(), alloc_2);
+    copy.resize(100);
+    copy.shrink_to_fit();
+    EXPECT_EQ(copy[5], "b");
+  }
+  EXPECT_EQ(live_1, 0);
+  EXPECT_EQ(live_2, 0);
+}
+// -----------------------------------------------------------------------------
+
+// ---Every block the vector takes is counted, per tag or per instance.---------
+struct counted_vector_tag {};
+
+TEST(vector, counting_allocator) {
+  typedef ft::CountingAllocator<int, ft::Allocator<int>, counted_vector_tag>
+      alloc;
+  ft::AllocationStats &shared = ft::allocation_stats<counted_vector_tag>();
+  shared.reset();
+  {
+    my::vector_<int, alloc> my_vector;
+    for (int i = 0; i < 100; ++i) {
+      my_vector.push_back(i);
+    }
+    EXPECT_EQ(shared.allocations(), shared.deallocations() + 1);
+    EXPECT_EQ(shared.live_bytes(), my_vector.capacity() * sizeof(int));
+    EXPECT_GE(shared.peak_bytes(), shared.live_bytes());
+  }
+  EXPECT_EQ(shared.live_bytes(), 0u);
+  EXPECT_EQ(shared.allocations(), shared.deallocations());
+  EXPECT_NE(shared.name().find("counted_vector_tag"), std::string::npos);
+  ft::AllocationStats own("one vector");
+  {
+    const alloc counted(&own);
+    my::vector_<int, alloc> my_vector(counted);
+    my_vector.reserve(8);
+    my_vector.reserve(1000);
+    EXPECT_EQ(own.allocations(), 2u);
+    EXPECT_EQ(own.allocated_bytes(), 1008 * sizeof(int));
+    EXPECT_EQ(own.peak_bytes(), 1008 * sizeof(int));
+    EXPECT_EQ(own.histogram(ft::AllocationStats::bucket(8 * sizeof(int))), 1u);
+  }
+  EXPECT_EQ(own.live_bytes(), 0u);
+  std::ostringstream report;
+  ft::report_allocations(report);
+  EXPECT_NE(report.str().find("one vector: 2 allocations"), std::string::npos);
+  // the inner allocator's extensions are forwarded and counted
+  static_assert(ft::has_allocate_zeroed<alloc>::value
+                    && ft::has_try_expand<alloc>::value
+                    && ft::has_reallocate<alloc>::value,
+                "forwarded from ft::Allocator");
+  typedef ft::CountingAllocator<int, std::allocator<int>, counted_vector_tag>
+      std_alloc;
+  static_assert(!ft::has_allocate_zeroed<std_alloc>::value
+                    && !ft::has_try_expand<std_alloc>::value
+                    && !ft::has_reallocate<std_alloc>::value,
+                "std::allocator has none of them");
+  shared.reset();
+  {
+    my::vector_<int, alloc> my_vector(1000);
+    EXPECT_EQ(my_vector[999], 0);
+    EXPECT_EQ(shared.allocations(), 1u);
+    EXPECT_EQ(shared.live_bytes(), 1000 * sizeof(int));
+  }
+  ft::AllocationStats zeroed("zeroed");
+  {
+    alloc inner(&zeroed);
+    size_t size = 1 << 20;
+    int *block = inner.allocate_zeroed(size);
+    EXPECT_EQ(block[size - 1], 0);
+    // the pages past the block may be taken, then it stays as it is
+    if (inner.try_expand(block, size, 1 << 21)) {
+      size = 1 << 21;
+    }
+    block[size - 1] = 1;
+    EXPECT_EQ(zeroed.allocations(), 1u);
+    EXPECT_EQ(zeroed.live_bytes(), size * sizeof(int));
+    block = inner.reallocate(block, size, 1 << 22);
+    EXPECT_EQ(block[size - 1], 1);
+    EXPECT_EQ(zeroed.live_bytes(), (1 << 22) * sizeof(int));
+    inner.deallocate(block, 1 << 22);
+  }
+  EXPECT_EQ(zeroed.live_bytes(), 0u);
+  EXPECT_EQ(zeroed.allocations(), zeroed.deallocations());
+  // elements are built by the inner allocator, so pmr ones get its resource
+  {
+    typedef my::pmr::vector<int> inner_vector;
+    typedef ft::CountingAllocator<inner_vector,
+        ft::pmr::polymorphic_allocator<inner_vector>, counted_vector_tag>
+        pmr_alloc;
+    ft::pmr::monotonic_buffer_resource arena;
+    const pmr_alloc counted(&own,
+                            ft::pmr::polymorphic_allocator<inner_vector>(
+                                &arena));
+    my::vector_<inner_vector, pmr_alloc> nested(counted);
+    nested.emplace_back(3, 7);
+    EXPECT_EQ(nested[0].get_allocator().resource(), &arena);
+    EXPECT_EQ(nested[0][2], 7);
+  }
+}
+// -----------------------------------------------------------------------------
+
+// ---PerfScope writes its line where it is told; counters it can't open are----
+// ---left out, down to the time alone.-----------------------------------------
+TEST(vector, perf_scope) {
+  std::ostringstream os;
+  bool any_counter = false;
+  {
+    ft::PerfScope scope("push_back", os);
+    for (int c = 0; c < ft::PerfScope::kCounters; ++c) {
+      any_counter = any_counter
+          || scope.available(static_cast<ft::PerfScope::Counter>(c));
+    }
+    my::vector_<int> my_vector;
+    for (int i = 0; i < 1000; ++i) {
+      my_vector.push_back(i);
+    }
+    EXPECT_TRUE(os.str().empty());
+  }
+  const std::string line = os.str();
+  const std::string prefix = "push_back: ";
+  ASSERT_EQ(line.compare(0, prefix.size(), prefix), 0);
+  const size_t digits = line.find_first_not_of("0123456789", prefix.size());
+  ASSERT_NE(digits, std::string::npos);
+  EXPECT_GT(digits, prefix.size());
+  EXPECT_EQ(line.compare(digits, 3, " ns"), 0);
+  if (!any_counter) {
+    EXPECT_EQ(line.substr(digits), " ns\n");
+  }
+}
+// -----------------------------------------------------------------------------
+
+// ---Tagged vectors count their growth per call site, unless their-------------
+// ---telemetry is switched off.------------------------------------------------
+struct growth_site {};
+
+TEST(vector, growth_telemetry) {
+  typedef ft::vector_telemetry<growth_site> telemetry;
+  typedef my::vector_<int, ft::Allocator<int>, ft::vector_strong_guarantee,
+                      telemetry> tagged_int;
+  typedef my::vector_<std::string, ft::Allocator<std::string>,
+                      ft::vector_strong_guarantee, telemetry> tagged_string;
+  static_assert(sizeof(tagged_int) == sizeof(my::vector_<int>),
+                "telemetry takes no room in the vector");
+  ft::VectorGrowthStats &stats = telemetry::stats();
+  stats.reset();
+  {
+    tagged_int my_vector;
+    my_vector.reserve(100);
+    for (int i = 0; i < 100; ++i) {
+      my_vector.push_back(i);
+    }
+    EXPECT_EQ(stats.reallocations(), 1u);
+    EXPECT_EQ(stats.peak_capacity(), 100u);
+  }
+  EXPECT_EQ(stats.released(), 1u);
+  EXPECT_DOUBLE_EQ(stats.capacity_ratio(), 1.0);
+  stats.reset();
+  {
+    tagged_string my_vector;
+    my_vector.reserve(4);
+    my_vector.push_back("a");
+    my_vector.push_back("b");
+    my_vector.push_back("c");
+    EXPECT_EQ(stats.moved(), 0u);
+    my_vector.insert(my_vector.begin(), "d");
+    EXPECT_EQ(stats.moved(), 3u);
+    my_vector.reserve(16);
+    EXPECT_EQ(stats.moved(), 7u);
+    EXPECT_EQ(stats.reallocations(), 2u);
+    EXPECT_EQ(stats.peak_capacity(), 16u);
+  }
+  EXPECT_DOUBLE_EQ(stats.capacity_ratio(), 4.0);
+  std::ostringstream report;
+  ft::report_vector_growth(report);
+  EXPECT_NE(report.str().find("growth_site: 2 reallocations"),
+            std::string::npos);
+  stats.reset();
+  {
+    my::vector_<int, ft::Allocator<int>, ft::vector_strong_guarantee,
+                ft::vector_telemetry<growth_site, false> > my_vector(10);
+    my_vector.reserve(100);
+  }
+  EXPECT_EQ(stats.reallocations(), 0u);
+  EXPECT_EQ(stats.released(), 0u);
+}
+// -----------------------------------------------------------------------------
+
 // ============================= RESIZE ========================================
 
 // -------Resizes the vector to the specified number of elements.---------------
@@ -1708,6 +2356,56 @@ TEST(vector, resize_value) {
 }
 // -----------------------------------------------------------------------------
 
+// -------Grows without initializing trivial elements; zeroes value-init.-------
+TEST(vector, resize_default_init) {
+  // default_init constructor
+  {
+    my::vector_<int> my_vector(100, ft::default_init);
+    EXPECT_EQ(my_vector.size(), 100u);
+    EXPECT_EQ(my_vector.capacity(), 100u);
+    for (int i = 0; i < 100; ++i) {
+      my_vector[i] = i;
+    }
+    my_vector.resize_default_init(1000);
+    ASSERT_EQ(my_vector.size(), 1000u);
+    EXPECT_EQ(my_vector[99], 99);
+    my_vector.resize_default_init(10);
+    EXPECT_EQ(my_vector.size(), 10u);
+    EXPECT_EQ(my_vector[9], 9);
+  }
+  // non-trivial elements are still constructed
+  {
+    my::vector_<A> my_vector(3, ft::default_init);
+    my_vector.resize_default_init(5);
+    ASSERT_EQ(my_vector.size(), 5u);
+    EXPECT_EQ(my_vector[4].GetCount(), 10);
+    my_vector.resize_default_init(2);
+    EXPECT_EQ(my_vector.size(), 2u);
+  }
+  // value-initialized elements are zero, mapped storage included
+  for (size_t size : {1000, 1 << 20}) {
+    my::vector_<long> my_vector(size);
+    EXPECT_EQ(std::count(my_vector.begin(), my_vector.end(), 0L),
+              static_cast<long>(size));
+    my_vector.assign(size, 7);
+    my_vector.resize(size / 2);
+    my_vector.resize(3 * size);
+    EXPECT_EQ(std::count(my_vector.begin(), my_vector.end(), 0L),
+              static_cast<long>(3 * size - size / 2));
+  }
+  // growth within the capacity
+  {
+    stl::_vector<double> stl_vector(10, 1.5);
+    my::vector_<double> my_vector(10, 1.5);
+    stl_vector.reserve(20);
+    my_vector.reserve(20);
+    stl_vector.resize(15);
+    my_vector.resize(15);
+    compare_vector<double>(my_vector, stl_vector);
+  }
+}
+// -----------------------------------------------------------------------------
+
 // =========================== SHRINK_TO_FIT ===================================
 
 // --------A non-binding request to reduce capacity() to size().----------------
@@ -1852,6 +2550,164 @@ TEST(vector, emplace_back) {
 }
 // -----------------------------------------------------------------------------
 
+// =============================== APPEND ======================================
+
+// ----Appends ranges and generated values, unchecked after a reserve.----------
+TEST(vector, append) {
+  // forward range
+  {
+    std::vector<std::string> source = {"a", "b", "c", "d", "e"};
+    stl::_vector<std::string> stl_vector(3, "x");
+    my::vector_<std::string> my_vector(3, "x");
+    stl_vector.insert(stl_vector.end(), source.begin(), source.end());
+    my_vector.append(source.begin(), source.end());
+    EXPECT_TRUE(std::equal(my_vector.begin(), my_vector.end(),
+                           stl_vector.begin(), stl_vector.end()));
+    my_vector.append(source.begin(), source.begin());
+    EXPECT_EQ(my_vector.size(), 8u);
+  }
+  // input range
+  {
+    std::istringstream input("1 2 3 4 5 6 7 8 9 10");
+    my::vector_<int> my_vector(2, 0);
+    my_vector.append(std::istream_iterator<int>(input),
+                     std::istream_iterator<int>());
+    ASSERT_EQ(my_vector.size(), 12u);
+    EXPECT_EQ(my_vector[2], 1);
+    EXPECT_EQ(my_vector[11], 10);
+  }
+  // append_n
+  {
+    my::vector_<A> my_vector(4);
+    int count = 0;
+    my_vector.append_n(100, [&count]() { return A(count++); });
+    ASSERT_EQ(my_vector.size(), 104u);
+    EXPECT_EQ(my_vector[3].GetCount(), 10);
+    EXPECT_EQ(my_vector[4].GetCount(), 0);
+    EXPECT_EQ(my_vector[103].GetCount(), 99);
+  }
+  // a throwing element leaves the vector as it was
+  {
+    std::vector<throw_on_copy> source(8, 7);
+    my::vector_<throw_on_copy> my_vector(2, 1);
+    throw_on_copy::countdown = 5;
+    EXPECT_THROW(my_vector.append(source.begin(), source.end()),
+                 std::runtime_error);
+    throw_on_copy::countdown = 0;
+    ASSERT_EQ(my_vector.size(), 2u);
+    EXPECT_EQ(my_vector[1].value, 1);
+    int count = 0;
+    EXPECT_THROW(my_vector.append_n(10, [&count]() {
+      if (++count == 6) {
+        throw std::runtime_error("generate");
+      }
+      return throw_on_copy(count);
+    }), std::runtime_error);
+    EXPECT_EQ(my_vector.size(), 2u);
+  }
+  // unchecked after reserve
+  {
+    A two(2);
+    my::vector_<A> my_vector;
+    my_vector.reserve(4);
+    A *data = my_vector.data();
+    my_vector.push_back_unchecked(two);
+    my_vector.push_back_unchecked(A(3));
+    my_vector.emplace_back_unchecked(4);
+    my_vector.emplace_back_unchecked();
+    EXPECT_EQ(my_vector.data(), data);
+    EXPECT_EQ(my_vector.size(), 4u);
+    EXPECT_EQ(my_vector[0].GetCount(), 2);
+    EXPECT_EQ(my_vector[1].GetCount(), 3);
+    EXPECT_EQ(my_vector[2].GetCount(), 4);
+    EXPECT_EQ(my_vector[3].GetCount(), 10);
+  }
+  // push_back of an element of the vector itself while it grows
+  {
+    stl::_vector<std::string> stl_vector(4, "value");
+    my::vector_<std::string> my_vector(4, "value");
+    stl_vector.push_back(stl_vector[1]);
+    my_vector.push_back(my_vector[1]);
+    my_vector.emplace_back(my_vector[2]);
+    stl_vector.emplace_back(stl_vector[2]);
+    compare_vector<std::string>(my_vector, stl_vector);
+  }
+}
+// -----------------------------------------------------------------------------
+
+// ============================= RADIX SORT ====================================
+
+// -------Sorts like std::stable_sort, by the value or by an extracted key.------
+template<class T>
+void radix_sort(size_t size, T (*generate)(std::mt19937_64 &)) {
+  std::mt19937_64 random(size);
+  stl::_vector<T> stl_vector;
+  my::vector_<T> my_vector;
+  for (size_t i = 0; i < size; ++i) {
+    stl_vector.push_back(generate(random));
+    my_vector.push_back(stl_vector.back());
+  }
+  std::sort(stl_vector.begin(), stl_vector.end());
+  ft::radix_sort(my_vector);
+  compare_vector<T>(my_vector, stl_vector);
+}
+
+TEST(vector, radix_sort) {
+  for (size_t size : {0, 1, 100, 100000}) {
+    radix_sort<unsigned char>(size, [](std::mt19937_64 &random) {
+      return static_cast<unsigned char>(random());
+    });
+    radix_sort<short>(size, [](std::mt19937_64 &random) {
+      return static_cast<short>(random());
+    });
+    radix_sort<int>(size, [](std::mt19937_64 &random) {
+      return static_cast<int>(random() % 1000) - 500;
+    });
+    radix_sort<long long>(size, [](std::mt19937_64 &random) {
+      return static_cast<long long>(random());
+    });
+    radix_sort<double>(size, [](std::mt19937_64 &random) {
+      return static_cast<double>(static_cast<int>(random() % 2000)) / -7.0;
+    });
+  }
+  // key extractor
+  {
+    stl::_vector<std::pair<int, std::string> > stl_vector;
+    my::vector_<std::pair<int, std::string> > my_vector;
+    for (int i = 0; i < 1000; ++i) {
+      stl_vector.push_back(std::make_pair(i * 7 % 10 - 5, std::to_string(i)));
+      my_vector.push_back(stl_vector.back());
+    }
+    std::stable_sort(stl_vector.begin(), stl_vector.end(),
+                     [](const std::pair<int, std::string> &a,
+                        const std::pair<int, std::string> &b) {
+                       return a.first < b.first;
+                     });
+    ft::radix_sort(my_vector, [](const std::pair<int, std::string> &x) {
+      return x.first;
+    });
+    compare_vector<std::pair<int, std::string> >(my_vector, stl_vector);
+  }
+  // scratch comes from an allocator with only the required members
+  long live = 0;
+  {
+    const minimal_allocator<long long> alloc(&live);
+    my::vector_<long long, minimal_allocator<long long> > my_vector(alloc);
+    stl::_vector<long long> stl_vector;
+    std::mt19937_64 random(3);
+    for (int i = 0; i < 1000; ++i) {
+      stl_vector.push_back(static_cast<long long>(random()));
+      my_vector.push_back(stl_vector.back());
+    }
+    std::sort(stl_vector.begin(), stl_vector.end());
+    ft::radix_sort(my_vector);
+    EXPECT_TRUE(std::equal(stl_vector.begin(), stl_vector.end(),
+                           my_vector.data()));
+  }
+  EXPECT_EQ(live, 0);
+}
+// -----------------------------------------------------------------------------
+
 // =============================================================================
 // ============================== ITERATORS ====================================
 // =============================================================================
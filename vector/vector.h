@@ -7,16 +7,36 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <utility>
 
 #include "tools/memory.h"
+#include "tools/memory_resource.h"
 #include "tools/reverse_iterator.h"
+#include "tools/telemetry.h"
 #include "tools/utility.h"
 #include "random_access_iterator.h"
 
 namespace ft {
 
-template<class T, class Alloc = ft::Allocator<T> >
+//  Exception guarantees for ft::vector's assign and range insert.  The strong
+//  one keeps a backup of the elements while overwriting them with values whose
+//  copy may throw; the basic one overwrites in place and, if a copy throws,
+//  leaves valid elements of unspecified value.  Values that copy without
+//  throwing are always written in place.
+struct vector_strong_guarantee {};
+struct vector_basic_guarantee {};
+
+//  Passed to a vector constructor to default-initialize the elements: those
+//  of trivial type are left uninitialized, for a caller about to write them.
+struct default_init_t {};
+const default_init_t default_init = default_init_t();
+
+template<class T, class Alloc = ft::Allocator<T>,
+         class Guarantee = ft::vector_strong_guarantee,
+         class Telemetry = ft::vector_no_telemetry>
 class vector {
 /*
 **                                Public Types
@@ -28,8 +48,8 @@ class vector {
   typedef ptrdiff_t difference_type;
   typedef value_type &reference;
   typedef const value_type &const_reference;
-  typedef typename allocator_type::pointer pointer;
-  typedef typename allocator_type::const_pointer const_pointer;
+  typedef typename std::allocator_traits<Alloc>::pointer pointer;
+  typedef typename std::allocator_traits<Alloc>::const_pointer const_pointer;
   typedef ft::random_access_iterator<T> iterator;
   typedef ft::random_access_iterator<const T> const_iterator;
   typedef ft::reverse_iterator<iterator> reverse_iterator;
@@ -46,6 +66,8 @@ class vector {
   inline explicit vector(size_type n);
   inline explicit vector(size_type n, const value_type &value,
                          const allocator_type &a = allocator_type());
+  inline vector(size_type n, ft::default_init_t,
+                const allocator_type &a = allocator_type());
   // range
   template<typename InputIterator>
   inline vector(InputIterator first, InputIterator last,
@@ -58,8 +80,7 @@ class vector {
                 const allocator_type& alloc);
   // move
   inline vector(vector &&x) noexcept;
-  inline vector(const vector &&x,
-                const allocator_type& alloc) noexcept;
+  inline vector(vector &&x, const allocator_type& alloc);
   // initializer list
   inline vector(std::initializer_list<value_type > l,
                 const allocator_type &a = allocator_type());
@@ -71,7 +92,10 @@ class vector {
   // copy
   inline vector &operator=(const vector &x);
   // move
-  inline vector &operator=(vector &&x) noexcept;
+  inline vector &operator=(vector &&x) noexcept(
+      std::allocator_traits<Alloc>::propagate_on_container_move_assignment
+          ::value
+      || std::allocator_traits<Alloc>::is_always_equal::value);
   // initializer list
   inline vector &operator=(std::initializer_list<value_type> l);
 
@@ -98,6 +122,8 @@ class vector {
 // -------------------------------Resize----------------------------------------
   inline void resize(size_type new_size);
   inline void resize(size_type new_size, const value_type &x);
+  // new elements of trivial type are left uninitialized
+  inline void resize_default_init(size_type new_size);
 
 // ------------------------------Capacity---------------------------------------
   inline size_type capacity() const noexcept;
@@ -116,6 +142,11 @@ class vector {
   inline const_reference operator[](size_type n) const;
   inline value_type *data() noexcept;
   inline const value_type *data() const noexcept;
+  // data() with the allocator's alignment promised to the compiler
+  inline value_type *aligned_data() noexcept;
+  inline const value_type *aligned_data() const noexcept;
+  static const size_type data_alignment
+      = ft::allocator_alignment<Alloc>::value;
   inline reference at(size_type n);
   inline const_reference at(size_type n) const;
   inline reference front();
@@ -137,6 +168,16 @@ class vector {
 // -----------------------------Push_back---------------------------------------
   inline void push_back(const value_type &x);
   inline void push_back(value_type &&x);
+  // the caller guarantees size() < capacity(), e.g. after reserve()
+  inline void push_back_unchecked(const value_type &x);
+  inline void push_back_unchecked(value_type &&x);
+
+// -------------------------------Append----------------------------------------
+  template<typename InputIterator>
+  inline void append(InputIterator first, InputIterator last);
+  // appends n elements constructed from successive calls to gen()
+  template<class Generator>
+  inline void append_n(size_type n, Generator gen);
 
 // ------------------------------Pop_back---------------------------------------
   inline void pop_back();
@@ -173,10 +214,15 @@ class vector {
   iterator emplace(const_iterator position, Args &&...args);
   template<typename... Args>
   inline void emplace_back(Args &&...args);
+  template<typename... Args>
+  inline void emplace_back_unchecked(Args &&...args);
 // --------------------------Get_allocator--------------------------------------
   inline allocator_type get_allocator() const noexcept;
 
  private:
+  typedef std::allocator_traits<Alloc> alloc_traits;
+  //  the allocator stays put: it moves between vectors only as its
+  //  propagate_on_container_* traits allow
   struct field {
     pointer data_;
     size_type size_;
@@ -202,7 +248,6 @@ class vector {
       }
       size_ = x.size_;
       capacity_ = x.capacity_;
-      alloc_ = x.alloc_;
       data_ = x.data_;
       x.capacity_ = x.size_ = 0;
       x.data_ = nullptr;
@@ -211,10 +256,21 @@ class vector {
     inline void swap(field &x) {
       std::swap(size_, x.size_);
       std::swap(capacity_, x.capacity_);
-      std::swap(alloc_, x.alloc_);
       std::swap(data_, x.data_);
     }
   } attributes_;
+  static const bool kBasicGuarantee = std::is_same<Guarantee,
+                                          ft::vector_basic_guarantee>::value;
+  static const bool kTrivialDefault
+      = std::is_trivially_default_constructible<T>::value;
+  //  value-initialized arithmetic elements are taken from zeroed storage
+  static const bool kZeroedStorage = std::is_arithmetic<T>::value
+      && ft::has_allocate_zeroed<Alloc>::value;
+  //  trivially copyable elements may change address with their bytes
+  static const bool kRelocatable = std::is_trivially_copyable<T>::value
+      && ft::has_reallocate<Alloc>::value;
+  static const bool kExpandable = kRelocatable
+      || ft::has_try_expand<Alloc>::value;
 
 /*
 **                         Private Member Functions
@@ -223,12 +279,17 @@ class vector {
   inline void initialize_storage(field &storage);
   inline void fill_initialize(field &storage, const value_type &value,
                               size_type size, size_type offset);
-  inline void default_initialize(field &storage, size_type size, size_type offset);
+  inline void default_initialize(field &storage, size_type size,
+                                 size_type offset);
+  inline void value_initialize(field &storage, size_type size,
+                               size_type offset, std::true_type);
+  inline void value_initialize(field &storage, size_type size,
+                               size_type offset, std::false_type);
   inline void clear_storage(field &storage, size_type offset);
   inline void destroy_storage(field &storage, size_type offset);
   template<class InputIt, class ForwardIt>
   inline ForwardIt uninitialized_copy(InputIt first, InputIt last,
-                                      ForwardIt d_first, const Alloc& alloc);
+                                      ForwardIt d_first, Alloc &alloc);
   template<typename InputIterator>
   inline void range_initialize(field &storage, InputIterator first,
                                InputIterator last, size_type offset);
@@ -246,52 +307,108 @@ class vector {
   inline void move_range(iterator position, size_type n);
   void move_old_data(field &storage, iterator position, size_type n);
   template<typename InputIterator>
-  void append_range_end(field &storage, size_type append_size, InputIterator first);
+  void append_range_end(field &storage, size_type append_size,
+                        InputIterator first);
+  template<typename InputIterator>
+  void range_construct(InputIterator first, InputIterator last,
+                       std::input_iterator_tag);
+  template<typename ForwardIterator>
+  void range_construct(ForwardIterator first, ForwardIterator last,
+                       std::forward_iterator_tag);
+  template<typename InputIterator>
+  void range_assign(InputIterator first, InputIterator last,
+                    std::input_iterator_tag);
+  template<typename ForwardIterator>
+  void range_assign(ForwardIterator first, ForwardIterator last,
+                    std::forward_iterator_tag);
+  template<typename InputIterator>
+  iterator range_insert(const_iterator position, InputIterator first,
+                        InputIterator last, std::input_iterator_tag);
+  template<typename ForwardIterator>
+  iterator range_insert(const_iterator position, ForwardIterator first,
+                        ForwardIterator last, std::forward_iterator_tag);
+  template<typename InputIterator>
+  void range_append(InputIterator first, InputIterator last,
+                    std::input_iterator_tag);
+  template<typename ForwardIterator>
+  void range_append(ForwardIterator first, ForwardIterator last,
+                    std::forward_iterator_tag);
+  template<class Ref>
+  static constexpr bool overwrite_in_place();
+  template<typename... Args>
+  __attribute__((cold, noinline)) void realloc_append(Args &&...args);
+  inline void grow_for(size_type n);
+  inline bool expand_storage(size_type n);
+  template<class Iterator>
+  inline bool own_element(Iterator it) const noexcept;
+  inline bool own_element(const T *p) const noexcept;
+  template<class U>
+  inline typename std::enable_if<std::is_same<
+      typename std::remove_const<U>::type,
+      typename std::remove_const<T>::type>::value, bool>::type
+  own_element_(U *p, int) const noexcept;
+  template<class U>
+  inline bool own_element_(ft::random_access_iterator<U> it,
+                           int) const noexcept;
+  template<class Iterator>
+  inline bool own_element_(ft::reverse_iterator<Iterator> it,
+                           int) const noexcept;
+  template<class Iterator>
+  inline bool own_element_(Iterator, long) const noexcept;
+  inline bool expand_in_place(size_type n, std::true_type);
+  inline bool expand_in_place(size_type n, std::false_type);
+  inline bool relocate_storage(size_type n, std::true_type);
+  inline bool relocate_storage(size_type n, std::false_type);
+  template<typename InputIterator>
+  void assign_in_place(InputIterator first, size_type n);
 };
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(const allocator_type &alloc)
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(const allocator_type &alloc)
                         : attributes_(nullptr, 0, 0, alloc) {}
 
-template<class T, class Alloc>
-void vector<T, Alloc>::clear_storage(vector::field &storage, size_type offset) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::clear_storage(
+    vector::field &storage, size_type offset) {
   for (size_type i = offset; i < storage.size_; ++i) {
-    storage.alloc_.destroy(storage.data_ + i);
+    alloc_traits::destroy(storage.alloc_, storage.data_ + i);
   }
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::destroy_storage(vector::field &storage, size_type offset) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::destroy_storage(
+    vector::field &storage, size_type offset) {
   clear_storage(storage, offset);
   if(storage.data_) {
-    storage.alloc_.deallocate(storage.data_, storage.capacity_);
+    alloc_traits::deallocate(storage.alloc_, storage.data_, storage.capacity_);
   }
   storage.set_zero();
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::initialize_storage(vector::field &storage) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::initialize_storage(
+    vector::field &storage) {
   if (storage.capacity_ > max_size()){
     throw ft::length_error("vector");
   }
   try {
     if (storage.capacity_ > 0) {
-      storage.data_ = storage.alloc_.allocate(storage.capacity_);
+      storage.data_ = alloc_traits::allocate(storage.alloc_, storage.capacity_);
     }
   } catch (...) {
     throw;
   }
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::fill_initialize(vector::field &storage,
-                                       const value_type &value,
-                                       vector::size_type size,
-                                       vector::size_type offset) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::fill_initialize(
+    vector::field &storage, const value_type &value, vector::size_type size,
+    vector::size_type offset) {
   initialize_storage(storage);
   for (size_type i = 0; i < size; ++i) {
     try {
-        storage.alloc_.construct(storage.data_ + offset + i, value);
+        alloc_traits::construct(storage.alloc_,
+                                storage.data_ + offset + i, value);
     } catch (...) {
       destroy_storage(storage, offset);
       throw;
@@ -299,86 +416,144 @@ void vector<T, Alloc>::fill_initialize(vector::field &storage,
   }
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::default_initialize(vector::field &storage,
-                                          vector::size_type size,
-                                          vector::size_type offset) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::default_initialize(
+    vector::field &storage, vector::size_type size, vector::size_type offset) {
+  value_initialize(storage, size, offset,
+                   std::integral_constant<bool, kZeroedStorage>());
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::value_initialize(
+    vector::field &storage, vector::size_type, vector::size_type,
+    std::true_type) {
+  if (storage.capacity_ > max_size()) {
+    throw ft::length_error("vector");
+  }
+  if (storage.capacity_ > 0) {
+    storage.data_ = storage.alloc_.allocate_zeroed(storage.capacity_);
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::value_initialize(
+    vector::field &storage, vector::size_type size, vector::size_type offset,
+    std::false_type) {
   initialize_storage(storage);
   for (size_type i = 0; i < size; ++i) {
     try {
-        storage.alloc_.construct(storage.data_ + offset + i);
+        alloc_traits::construct(storage.alloc_, storage.data_ + offset + i);
     } catch (...) {
+      storage.size_ = offset + i;
       destroy_storage(storage, offset);
       throw;
     }
   }
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(vector::size_type n)
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(vector::size_type n)
                         : attributes_(nullptr, n, n) {
   default_initialize(attributes_, attributes_.size_, 0);
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(vector::size_type n,
-                         const value_type &value,
-                         const allocator_type &a)
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(vector::size_type n,
+                                               const value_type &value,
+                                               const allocator_type &a)
                          : attributes_(nullptr, n, n, a) {
   fill_initialize(attributes_, value, attributes_.size_, 0);
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::~vector() noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(vector::size_type n,
+                                               ft::default_init_t,
+                                               const allocator_type &a)
+    : attributes_(nullptr, n, n, a) {
+  if (kTrivialDefault) {
+    initialize_storage(attributes_);
+  } else {
+    default_initialize(attributes_, attributes_.size_, 0);
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::~vector() noexcept {
+  Telemetry::released(attributes_.size_, attributes_.capacity_);
   destroy_storage(attributes_, 0);
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::size() const noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::size_type
+    vector<T, Alloc, Guarantee, Telemetry>::size() const noexcept {
   return attributes_.size_;
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::max_size() const noexcept {
-  return std::min<size_type>(attributes_.alloc_.max_size(),
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::size_type
+    vector<T, Alloc, Guarantee, Telemetry>::max_size() const noexcept {
+  return std::min<size_type>(alloc_traits::max_size(attributes_.alloc_),
                              std::numeric_limits<difference_type>::max());
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::reference vector<T, Alloc>::operator[](
-    vector::size_type n) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::reference
+    vector<T, Alloc, Guarantee, Telemetry>::operator[](vector::size_type n) {
   return attributes_.data_[n];
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reference vector<T, Alloc>::operator[](
-    vector::size_type n) const {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reference
+    vector<T, Alloc, Guarantee, Telemetry>::operator[](
+        vector::size_type n) const {
   return attributes_.data_[n];
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::capacity() const noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::size_type
+    vector<T, Alloc, Guarantee, Telemetry>::capacity() const noexcept {
   return attributes_.capacity_;
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename InputIterator>
+vector<T, Alloc, Guarantee, Telemetry>::vector(
+    InputIterator first, InputIterator last, const allocator_type &a,
+    typename std::enable_if<!std::numeric_limits<
+        InputIterator>::is_specialized>::type *)
+    : attributes_(nullptr, 0, 0, a) {
+  range_construct(first, last,
+      typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+//  a single-pass range can't be measured up front, so it grows as it goes
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename InputIterator>
-vector<T, Alloc>::vector(InputIterator first,
-                         InputIterator last,
-                         const allocator_type &a,
-                         typename std::enable_if
-<!std::numeric_limits<InputIterator>::is_specialized>::type *)
-                        : attributes_(nullptr, 0, 0, a) {
+void vector<T, Alloc, Guarantee, Telemetry>::range_construct(
+    InputIterator first, InputIterator last, std::input_iterator_tag) {
+  try {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  } catch (...) {
+    destroy_storage(attributes_, 0);
+    throw;
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename ForwardIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::range_construct(
+    ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
   attributes_.size_ = attributes_.capacity_ = std::distance(first, last);
   range_initialize(attributes_, first, last, 0);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename InputIterator>
-void vector<T, Alloc>::range_initialize(vector::field &storage,
-                                        InputIterator first,
-                                        InputIterator last,
-                                        vector::size_type offset) {
+void vector<T, Alloc, Guarantee, Telemetry>::range_initialize(
+    vector::field &storage, InputIterator first, InputIterator last,
+    vector::size_type offset) {
   initialize_storage(storage);
   try {
     uninitialized_copy(first, last, iterator(storage.data_ + offset),
@@ -389,170 +564,210 @@ void vector<T, Alloc>::range_initialize(vector::field &storage,
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<class InputIt, class ForwardIt>
-ForwardIt vector<T, Alloc>::uninitialized_copy(InputIt first, InputIt last,
-                                               ForwardIt d_first,
-                                               const allocator_type &alloc) {
+ForwardIt vector<T, Alloc, Guarantee, Telemetry>::uninitialized_copy(
+    InputIt first, InputIt last, ForwardIt d_first, allocator_type &alloc) {
   ForwardIt current = d_first;
   try {
     for (; first != last; ++first, ++current) {
-      alloc.construct(current.base(), *first);
+      alloc_traits::construct(alloc, current.base(), *first);
     }
     return current;
   } catch (...) {
     for (; d_first != current; ++d_first) {
-      alloc.destroy(d_first.base());
+      alloc_traits::destroy(alloc, d_first.base());
     }
     throw;
   }
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(std::initializer_list<value_type> l,
-                         const allocator_type &a)
-                        : attributes_(nullptr, 0, 0, a) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(
+    std::initializer_list<value_type> l, const allocator_type &a)
+    : attributes_(nullptr, 0, 0, a) {
   attributes_.size_ = attributes_.capacity_ = std::distance(l.begin(), l.end());
   range_initialize(attributes_, l.begin(), l.end(), 0);
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::begin() noexcept {
-  return ft::vector<T, Alloc>::iterator(attributes_.data_);
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::begin() noexcept {
+  return iterator(attributes_.data_);
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_iterator vector<T, Alloc>::begin() const noexcept {
-  return ft::vector<T, Alloc>::const_iterator(attributes_.data_);
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::begin() const noexcept {
+  return const_iterator(attributes_.data_);
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::end() noexcept {
-  return ft::vector<T, Alloc>::iterator(attributes_.data_ + attributes_.size_);
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::end() noexcept {
+  return iterator(attributes_.data_ + attributes_.size_);
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_iterator vector<T, Alloc>::end() const noexcept {
-  return ft::vector<T, Alloc>::const_iterator(attributes_.data_ + attributes_.size_);
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::end() const noexcept {
+  return const_iterator(attributes_.data_ + attributes_.size_);
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(const vector &x)
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(const vector &x)
                          : attributes_(nullptr, x.attributes_.size_,
                                        x.attributes_.size_,
-                                       x.attributes_.alloc_) {
+                                       alloc_traits
+    ::select_on_container_copy_construction(x.attributes_.alloc_)) {
   range_initialize(attributes_, x.begin(), x.end(), 0);
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(const vector &x, const allocator_type& alloc)
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(const vector &x,
+                                               const allocator_type& alloc)
     : attributes_(nullptr, x.attributes_.size_,
                   x.attributes_.capacity_,
                   alloc) {
   range_initialize(attributes_, x.begin(), x.end(), 0);
 }
-template<class T, class Alloc>
-vector<T, Alloc>::vector(vector &&x) noexcept
-    : attributes_(nullptr, 0, 0) {
-  std::swap(attributes_.data_, x.attributes_.data_);
-  std::swap(attributes_.capacity_, x.attributes_.capacity_);
-  std::swap(attributes_.size_, x.attributes_.size_);
-  std::swap(attributes_.alloc_, x.attributes_.alloc_);
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(vector &&x) noexcept
+    : attributes_(nullptr, 0, 0, x.attributes_.alloc_) {
+  attributes_.swap(x.attributes_);
 }
 
-template<class T, class Alloc>
-vector<T, Alloc>::vector(const vector &&x,
-                         const allocator_type &alloc) noexcept
+//  storage from an unequal allocator can't be taken over, so the elements
+//  are moved one by one
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry>::vector(vector &&x,
+                                               const allocator_type &alloc)
     : attributes_(nullptr, 0, 0, alloc) {
-  std::swap(attributes_.data_, x.attributes_.data_);
-  std::swap(attributes_.capacity_, x.attributes_.capacity_);
-  std::swap(attributes_.rbeginsize_, x.attributes_.size_);
-  std::swap(attributes_.alloc_, x.attributes_.alloc_);
+  if (attributes_.alloc_ == x.attributes_.alloc_) {
+    attributes_.swap(x.attributes_);
+    return;
+  }
+  attributes_.size_ = attributes_.capacity_ = x.attributes_.size_;
+  range_initialize(attributes_, std::make_move_iterator(x.begin()),
+                   std::make_move_iterator(x.end()), 0);
 }
-template<class T, class Alloc>
-vector<T, Alloc> &vector<T, Alloc>::operator=(const vector &x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry> &
+    vector<T, Alloc, Guarantee, Telemetry>::operator=(const vector &x) {
   if (this == &x) {
     return *this;
   }
+  //  memory from the old allocator goes back to it before it is replaced
+  if (alloc_traits::propagate_on_container_copy_assignment::value
+      && attributes_.alloc_ != x.attributes_.alloc_) {
+    destroy_storage(attributes_, 0);
+  }
+  ft::propagate_on_copy_assignment(attributes_.alloc_, x.attributes_.alloc_);
   if (attributes_.capacity_ < x.attributes_.capacity_) {
     field new_storage(nullptr, x.attributes_.size_, x.attributes_.capacity_,
-                      x.attributes_.alloc_);
+                      attributes_.alloc_);
     range_initialize(new_storage, x.begin(), x.end(), 0);
+    Telemetry::reallocated(new_storage.capacity_);
     destroy_storage(attributes_, 0);
     attributes_ = std::move(new_storage);
   } else {
     this->clear();
-    uninitialized_copy(x.begin(), x.end(), this->begin(), x.attributes_.alloc_);
+    uninitialized_copy(x.begin(), x.end(), this->begin(), attributes_.alloc_);
     attributes_.size_ = x.attributes_.size_;
-    attributes_.alloc_ = x.attributes_.alloc_;
   }
   return *this;
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::clear() noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::clear() noexcept {
   clear_storage(attributes_, 0);
   attributes_.size_ = 0;
 }
 
-template<class T, class Alloc>
-vector<T, Alloc> &vector<T, Alloc>::operator=(vector &&x) noexcept {
-  this->~vector();
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry> &
+    vector<T, Alloc, Guarantee, Telemetry>::operator=(vector &&x)
+    noexcept(
+        std::allocator_traits<Alloc>::propagate_on_container_move_assignment
+            ::value
+        || std::allocator_traits<Alloc>::is_always_equal::value) {
+  if (this == &x) {
+    return *this;
+  }
+  if (!alloc_traits::propagate_on_container_move_assignment::value
+      && attributes_.alloc_ != x.attributes_.alloc_) {
+    range_assign(std::make_move_iterator(x.begin()),
+                 std::make_move_iterator(x.end()),
+                 std::forward_iterator_tag());
+    return *this;
+  }
+  destroy_storage(attributes_, 0);
+  ft::propagate_on_move_assignment(attributes_.alloc_, x.attributes_.alloc_);
   attributes_ = std::move(x.attributes_);
   return *this;
 }
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_iterator vector<T, Alloc>::cbegin() const noexcept{
-  return vector<T, Alloc>::begin();
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::cbegin() const noexcept{
+  return vector<T, Alloc, Guarantee, Telemetry>::begin();
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_iterator vector<T, Alloc>::cend() const noexcept{
-  return vector<T, Alloc>::end();
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::cend() const noexcept{
+  return vector<T, Alloc, Guarantee, Telemetry>::end();
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::crbegin() const noexcept{
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reverse_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::crbegin() const noexcept{
   return rbegin();
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::crend() const noexcept{
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reverse_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::crend() const noexcept{
   return rend();
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::reverse_iterator vector<T, Alloc>::rbegin() noexcept{
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::reverse_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::rbegin() noexcept{
   return reverse_iterator(end());
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::rbegin() const noexcept{
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reverse_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::rbegin() const noexcept{
   return const_reverse_iterator(end());
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::reverse_iterator vector<T, Alloc>::rend() noexcept{
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::reverse_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::rend() noexcept{
   return reverse_iterator(begin());
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reverse_iterator vector<T, Alloc>::rend() const noexcept{
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reverse_iterator
+    vector<T, Alloc, Guarantee, Telemetry>::rend() const noexcept{
   return const_reverse_iterator(begin());
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename ForwardIt>
-void vector<T, Alloc>::erase_at_end(ForwardIt first, ForwardIt last) {
+void vector<T, Alloc, Guarantee, Telemetry>::erase_at_end(
+    ForwardIt first, ForwardIt last) {
   attributes_.size_ -= (last - first);
   for (; first != last; ++first) {
-    attributes_.alloc_.destroy(first.base());
+    alloc_traits::destroy(attributes_.alloc_, first.base());
   }
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::get_new_capacity(
-                                                          vector::size_type n) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::size_type
+    vector<T, Alloc, Guarantee, Telemetry>::get_new_capacity(
+        vector::size_type n) {
   if (attributes_.capacity_ * 2 < attributes_.size_ + n) {
     return (attributes_.size_ + n);
   }
@@ -563,30 +778,33 @@ typename vector<T, Alloc>::size_type vector<T, Alloc>::get_new_capacity(
   return (new_cap);
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::append_end(vector::field &storage,
-                                  size_type append_size) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::append_end(vector::field &storage,
+                                                        size_type append_size) {
   for (size_type i = 0; i < append_size; ++i) {
     try {
-      storage.alloc_.construct(storage.data_ + storage.size_ + i);
+      alloc_traits::construct(storage.alloc_,
+                              storage.data_ + storage.size_ + i);
     } catch (...) {
       for (; i > 0; --i) {
-        storage.alloc_.destroy(storage.data_ + storage.size_ + i);
+        alloc_traits::destroy(storage.alloc_,
+                              storage.data_ + storage.size_ + i - 1);
       }
       throw;
     }
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<class InputIt>
-void vector<T, Alloc>::uninitialized_move(InputIt first, InputIt last,
-                                          field &storage) {
+void vector<T, Alloc, Guarantee, Telemetry>::uninitialized_move(
+    InputIt first, InputIt last, field &storage) {
   iterator current = iterator(storage.data_);
   iterator first_copy = first;
   try {
     for (; first != last; ++first, ++current) {
-      attributes_.alloc_.construct(current.base(), std::move_if_noexcept(*first));
+      alloc_traits::construct(attributes_.alloc_,
+                              current.base(), std::move_if_noexcept(*first));
     }
   } catch (...) {
     std::move_backward(iterator(storage.data_), current,
@@ -594,17 +812,20 @@ void vector<T, Alloc>::uninitialized_move(InputIt first, InputIt last,
     destroy_storage(storage, storage.size_);
     throw;
   }
+  Telemetry::moved(current - iterator(storage.data_));
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::default_append(vector::size_type append_size) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::default_append(
+    vector::size_type append_size) {
   if (attributes_.capacity_ >= attributes_.size_ + append_size) {
+    append_end(attributes_, append_size);
+    attributes_.size_ += append_size;
+    return;
+  }
+  if (expand_storage(get_new_capacity(append_size))) {
+    append_end(attributes_, append_size);
     attributes_.size_ += append_size;
-    try {
-      append_end(attributes_, append_size);
-    } catch (...) {
-      attributes_.size_ -= append_size;
-    }
     return;
   }
   field new_storage(nullptr, attributes_.size_,
@@ -613,12 +834,14 @@ void vector<T, Alloc>::default_append(vector::size_type append_size) {
   default_initialize(new_storage, append_size, new_storage.size_);
   uninitialized_move(begin(), end(), new_storage);
   new_storage.size_ += append_size;
+  Telemetry::reallocated(new_storage.capacity_);
   destroy_storage(attributes_, 0);
   attributes_ = std::move(new_storage);
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::resize(vector::size_type new_size) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::resize(
+    vector::size_type new_size) {
   if (new_size > max_size()) {
     throw ft::length_error("vector");
   }
@@ -629,108 +852,198 @@ void vector<T, Alloc>::resize(vector::size_type new_size) {
   }
 }
 
-template<class T, class Alloc>
-bool vector<T, Alloc>::empty() const noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::resize_default_init(
+    vector::size_type new_size) {
+  if (!kTrivialDefault) {
+    resize(new_size);
+    return;
+  }
+  if (new_size > max_size()) {
+    throw ft::length_error("vector");
+  }
+  if (new_size <= attributes_.size_) {
+    erase_at_end(begin() + new_size, end());
+    return;
+  }
+  if (new_size > attributes_.capacity_) {
+    reserve(get_new_capacity(new_size - attributes_.size_));
+  }
+  attributes_.size_ = new_size;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::empty() const noexcept {
   return (!attributes_.size_);
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::reserve(vector::size_type n) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::reserve(vector::size_type n) {
   if (n <= attributes_.capacity_) return;
+  if (expand_storage(n)) {
+    return;
+  }
   field new_storage(nullptr, 0, n, attributes_.alloc_);
-  new_storage.data_ = new_storage.alloc_.allocate(new_storage.capacity_);
+  new_storage.data_ = alloc_traits::allocate(new_storage.alloc_,
+                                             new_storage.capacity_);
   new_storage.size_ = attributes_.size_;
   uninitialized_move(begin(), end(), new_storage);
+  Telemetry::reallocated(new_storage.capacity_);
   destroy_storage(attributes_, 0);
   attributes_ = std::move(new_storage);
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::shrink_to_fit() {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::shrink_to_fit() {
   if (attributes_.size_ == attributes_.capacity_) {
     return;
   }
   field new_storage(nullptr, 0, attributes_.size_, attributes_.alloc_);
-  new_storage.data_ = new_storage.alloc_.allocate(new_storage.capacity_);
+  new_storage.data_ = alloc_traits::allocate(new_storage.alloc_,
+                                             new_storage.capacity_);
   new_storage.size_ = attributes_.size_;
   uninitialized_move(begin(), end(), new_storage);
+  Telemetry::reallocated(new_storage.capacity_);
   destroy_storage(attributes_, 0);
   attributes_ = std::move(new_storage);
 }
 
-template<class T, class Alloc>
-T *vector<T, Alloc>::data() noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+T *vector<T, Alloc, Guarantee, Telemetry>::data() noexcept {
   return attributes_.data_;
 }
 
-template<class T, class Alloc>
-const T *vector<T, Alloc>::data() const noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+const T *vector<T, Alloc, Guarantee, Telemetry>::data() const noexcept {
   return attributes_.data_;
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::allocator_type vector<T, Alloc>
-    ::get_allocator() const noexcept {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+T *vector<T, Alloc, Guarantee, Telemetry>::aligned_data() noexcept {
+  return static_cast<T *>(
+      __builtin_assume_aligned(attributes_.data_, data_alignment));
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+const T *vector<T, Alloc, Guarantee, Telemetry>::aligned_data() const noexcept {
+  return static_cast<const T *>(
+      __builtin_assume_aligned(attributes_.data_, data_alignment));
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+const typename vector<T, Alloc, Guarantee, Telemetry>::size_type
+    vector<T, Alloc, Guarantee, Telemetry>::data_alignment;
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::allocator_type
+    vector<T, Alloc, Guarantee, Telemetry>::get_allocator() const noexcept {
   return attributes_.alloc_;
 }
-template<class T, class Alloc>
-typename vector<T, Alloc>::reference vector<T, Alloc>::front() {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::reference
+    vector<T, Alloc, Guarantee, Telemetry>::front() {
   return *attributes_.data_;
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reference vector<T, Alloc>::front() const {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reference
+    vector<T, Alloc, Guarantee, Telemetry>::front() const {
   return *attributes_.data_;
 }
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 
-typename vector<T, Alloc>::reference vector<T, Alloc>::back() {
+typename vector<T, Alloc, Guarantee, Telemetry>::reference
+    vector<T, Alloc, Guarantee, Telemetry>::back() {
   return attributes_.data_[attributes_.size_ - 1];
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reference vector<T, Alloc>::back() const {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reference
+    vector<T, Alloc, Guarantee, Telemetry>::back() const {
   return attributes_.data_[attributes_.size_ - 1];
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::reference vector<T, Alloc>::at(vector::size_type n) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::reference
+    vector<T, Alloc, Guarantee, Telemetry>::at(vector::size_type n) {
   if (n >= attributes_.size_) {
     throw ft::out_of_range("vector");
   }
   return attributes_.data_[n];
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::const_reference vector<T, Alloc>::at(
-    vector::size_type n) const {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::const_reference
+    vector<T, Alloc, Guarantee, Telemetry>::at(vector::size_type n) const {
   if (n >= attributes_.size_) {
     throw ft::out_of_range("vector");
   }
   return attributes_.data_[n];
 }
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename InputIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::assign(
+    InputIterator first, InputIterator last,
+    typename std::enable_if<!std::numeric_limits<
+        InputIterator>::is_specialized>::type *) {
+  range_assign(first, last,
+      typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+//  Overwrites while the input lasts.  When that may throw under the strong
+//  policy the input is buffered first and then moved in like a forward range.
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename InputIterator>
-void vector<T, Alloc>::assign(InputIterator first,
-                              InputIterator last,
-                              typename std::enable_if<!std::numeric_limits<
-                                  InputIterator>::is_specialized>::type *) {
+void vector<T, Alloc, Guarantee, Telemetry>::range_assign(
+    InputIterator first, InputIterator last, std::input_iterator_tag) {
+  if (!overwrite_in_place<decltype(*first)>()) {
+    vector buffer(first, last, attributes_.alloc_);
+    range_assign(std::make_move_iterator(buffer.data()),
+                 std::make_move_iterator(buffer.data() + buffer.size()),
+                 std::forward_iterator_tag());
+    return;
+  }
+  size_type i = 0;
+  for (; first != last && i < attributes_.size_; ++first, ++i) {
+    attributes_.data_[i] = *first;
+  }
+  if (first == last) {
+    erase_at_end(begin() + i, end());
+    return;
+  }
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename ForwardIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::range_assign(
+    ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
   const difference_type n = std::distance(first, last);
   if (n < 0) {
     this->~vector();
     throw ft::length_error("vector");
   }
-  field new_storage(nullptr, n, n);
+  if (attributes_.capacity_ >= static_cast<size_type>(n)
+      && overwrite_in_place<decltype(*first)>()) {
+    assign_in_place(first, n);
+    return;
+  }
+  field new_storage(nullptr, n, n, attributes_.alloc_);
   range_initialize(new_storage, first, last, 0);
   if (attributes_.capacity_ < static_cast<size_type>(n)) {
+    Telemetry::reallocated(new_storage.capacity_);
     destroy_storage(attributes_, 0);
     attributes_.swap(new_storage);
   } else {
-    ft::vector<T, Alloc> copy_vector(begin(), end());
+    ft::vector<T, Alloc, Guarantee, Telemetry> copy_vector(begin(), end(),
+                                                           attributes_.alloc_);
     clear();
     try {
-      uninitialized_move(iterator(new_storage.data_), iterator(new_storage.data_ +
-      new_storage.size_), attributes_);
+      uninitialized_move(iterator(new_storage.data_),
+                         iterator(new_storage.data_ + new_storage.size_),
+                         attributes_);
     } catch (...) {
       attributes_ = std::move(copy_vector.attributes_);
       throw;
@@ -740,46 +1053,91 @@ void vector<T, Alloc>::assign(InputIterator first,
   attributes_.size_ = n;
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::resize(vector::size_type new_size, const value_type &x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::resize(
+    vector::size_type new_size, const value_type &x) {
   if (new_size > attributes_.size_)
     insert(end(), new_size - attributes_.size_, x);
   else if (new_size < attributes_.size_)
     erase_at_end(begin() + new_size, end());
 }
 
-template<class T, class Alloc>
-bool vector<T, Alloc>::compareForIdentity(const value_type &a,
-                                          const value_type &b) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class Ref>
+constexpr bool vector<T, Alloc, Guarantee, Telemetry>::overwrite_in_place() {
+  return kBasicGuarantee
+      || (std::is_nothrow_constructible<value_type, Ref>::value
+          && std::is_nothrow_assignable<value_type &, Ref>::value);
+}
+
+//  copy-assigns over the live elements, then constructs the surplus or
+//  destroys the tail; the capacity must already hold 'n' elements
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename InputIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::assign_in_place(
+    InputIterator first, vector::size_type n) {
+  size_type i = 0;
+  for (; i < n && i < attributes_.size_; ++i, ++first) {
+    attributes_.data_[i] = *first;
+  }
+  if (i < attributes_.size_) {
+    erase_at_end(begin() + i, end());
+  }
+  for (; i < n; ++i, ++first) {
+    alloc_traits::construct(attributes_.alloc_, attributes_.data_ + i, *first);
+    ++attributes_.size_;
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::compareForIdentity(
+    const value_type &a, const value_type &b) {
   return &a==&b;
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::assign(vector::size_type n, const value_type &val) {
-  if (n < 0) {
-    this->~vector();
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::assign(
+    vector::size_type n, const value_type &val) {
+  if (n > max_size()) {
     throw ft::length_error("vector");
   }
+  if (attributes_.capacity_ >= n
+      && overwrite_in_place<const value_type &>()) {
+    size_type i = 0;
+    for (; i < n && i < attributes_.size_; ++i) {
+      attributes_.data_[i] = val;
+    }
+    for (; i < n; ++i) {
+      alloc_traits::construct(attributes_.alloc_, attributes_.data_ + i, val);
+      ++attributes_.size_;
+    }
+    if (n < attributes_.size_) {
+      erase_at_end(begin() + n, end());
+    }
+    return;
+  }
   if (attributes_.capacity_ < n) {
-    field new_storage(nullptr, n, n);
+    field new_storage(nullptr, n, n, attributes_.alloc_);
     fill_initialize(new_storage, val, n, 0);
+    Telemetry::reallocated(new_storage.capacity_);
     destroy_storage(attributes_, 0);
     attributes_.swap(new_storage);
     destroy_storage(new_storage, 0);
   } else {
-    ft::vector<T, Alloc> copy_vector(begin(), end());
+    ft::vector<T, Alloc, Guarantee, Telemetry> copy_vector(begin(), end(),
+                                                           attributes_.alloc_);
     for (size_type i = 0; i < attributes_.size_; ++i) {
       if (compareForIdentity(*(attributes_.data_ + i), val)) {
         continue;
       }
-      attributes_.alloc_.destroy(attributes_.data_ + i);
+      alloc_traits::destroy(attributes_.alloc_, attributes_.data_ + i);
     }
     for (size_type i = 0; i < n; ++i) {
       try {
         if (compareForIdentity(*(attributes_.data_ + i), val)) {
           continue;
         }
-        attributes_.alloc_.construct(attributes_.data_ + i, val);
+        alloc_traits::construct(attributes_.alloc_, attributes_.data_ + i, val);
       } catch (...) {
         attributes_ = std::move(copy_vector.attributes_);
         throw;
@@ -788,75 +1146,279 @@ void vector<T, Alloc>::assign(vector::size_type n, const value_type &val) {
   };
   attributes_.size_ = n;
 }
-template<class T, class Alloc>
-void vector<T, Alloc>::assign(std::initializer_list<value_type> l) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::assign(
+    std::initializer_list<value_type> l) {
   assign(l.begin(), l.end());
 }
 
-template<class T, class Alloc>
-vector<T, Alloc> &vector<T, Alloc>::operator=(std::initializer_list<value_type> l) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+vector<T, Alloc, Guarantee, Telemetry> &
+    vector<T, Alloc, Guarantee, Telemetry>::operator=(
+        std::initializer_list<value_type> l) {
   this->assign(l.begin(), l.end());
   return *this;
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::push_back(const value_type &x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::push_back(const value_type &x) {
   if (attributes_.capacity_ != attributes_.size_) {
-    attributes_.alloc_.construct(attributes_.data_ + attributes_.size_, x);
+    alloc_traits::construct(attributes_.alloc_,
+                            attributes_.data_ + attributes_.size_, x);
     ++attributes_.size_;
   } else {
-    insert(end(), x);
+    realloc_append(x);
   }
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::push_back(value_type &&x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::push_back(value_type &&x) {
   emplace_back(std::move(x));
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::pop_back() {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::push_back_unchecked(
+    const value_type &x) {
+  alloc_traits::construct(attributes_.alloc_,
+                          attributes_.data_ + attributes_.size_, x);
+  ++attributes_.size_;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::push_back_unchecked(
+    value_type &&x) {
+  alloc_traits::construct(attributes_.alloc_,
+                          attributes_.data_ + attributes_.size_,
+                          std::move(x));
+  ++attributes_.size_;
+}
+
+//  growth for push_back and emplace_back, kept out of their inlined bodies
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename... Args>
+void vector<T, Alloc, Guarantee, Telemetry>::realloc_append(Args &&... args) {
+  if (!kExpandable || attributes_.size_ == max_size()) {
+    emplace(end(), std::forward<Args>(args) ...);
+    return;
+  }
+  // args may refer to an element that a relocation moves
+  value_type value(std::forward<Args>(args) ...);
+  if (expand_storage(get_new_capacity(1))) {
+    push_back_unchecked(std::move(value));
+  } else {
+    emplace(end(), std::move(value));
+  }
+}
+
+//  makes room for n more elements with the usual geometric growth
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::grow_for(vector::size_type n) {
+  if (attributes_.capacity_ - attributes_.size_ >= n) {
+    return;
+  }
+  if (n > max_size() - attributes_.size_) {
+    throw ft::length_error("vector");
+  }
+  reserve(get_new_capacity(n));
+}
+
+//  Grows the storage to n elements without moving them one by one: in place
+//  if the allocator can, else by relocating the bytes of trivially copyable
+//  elements.  False if neither applies; nothing has changed then.
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::expand_storage(
+    vector::size_type n) {
+  if (!attributes_.data_) {
+    return false;
+  }
+  return expand_in_place(n, ft::has_try_expand<Alloc>())
+      || relocate_storage(n, std::integral_constant<bool, kRelocatable>());
+}
+
+//  true if the argument points into this vector, its end included; a range
+//  from the vector itself must stay where it is until it has been copied.
+//  Pointers and iterators of this vector are checked by the address they
+//  hold, reverse ones by what they wrap; anything else can't point into it.
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class Iterator>
+bool vector<T, Alloc, Guarantee, Telemetry>::own_element(
+    Iterator it) const noexcept {
+  return own_element_(it, 0);
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::own_element(
+    const T *p) const noexcept {
+  return p >= attributes_.data_ && p <= attributes_.data_ + attributes_.size_;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class U>
+typename std::enable_if<std::is_same<
+    typename std::remove_const<U>::type,
+    typename std::remove_const<T>::type>::value, bool>::type
+    vector<T, Alloc, Guarantee, Telemetry>::own_element_(
+        U *p, int) const noexcept {
+  return own_element(static_cast<const T *>(p));
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class U>
+bool vector<T, Alloc, Guarantee, Telemetry>::own_element_(
+    ft::random_access_iterator<U> it, int) const noexcept {
+  return own_element_(it.base(), 0);
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class Iterator>
+bool vector<T, Alloc, Guarantee, Telemetry>::own_element_(
+    ft::reverse_iterator<Iterator> it, int) const noexcept {
+  return own_element_(it.base(), 0);
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class Iterator>
+bool vector<T, Alloc, Guarantee, Telemetry>::own_element_(
+    Iterator, long) const noexcept {
+  return false;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::expand_in_place(
+    vector::size_type n, std::true_type) {
+  if (!attributes_.alloc_.try_expand(attributes_.data_,
+                                     attributes_.capacity_, n)) {
+    return false;
+  }
+  attributes_.capacity_ = n;
+  Telemetry::reallocated(n);
+  return true;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::expand_in_place(vector::size_type,
+                                                             std::false_type) {
+  return false;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::relocate_storage(
+    vector::size_type n, std::true_type) {
+  attributes_.data_ = attributes_.alloc_.reallocate(attributes_.data_,
+                                                    attributes_.capacity_, n);
+  attributes_.capacity_ = n;
+  Telemetry::reallocated(n);
+  return true;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+bool vector<T, Alloc, Guarantee, Telemetry>::relocate_storage(vector::size_type,
+                                                              std::false_type) {
+  return false;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename InputIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::append(InputIterator first,
+                                                    InputIterator last) {
+  range_append(first, last,
+      typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename InputIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::range_append(
+    InputIterator first, InputIterator last, std::input_iterator_tag) {
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+}
+
+//  one growth check for the whole range, then unchecked construction
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename ForwardIterator>
+void vector<T, Alloc, Guarantee, Telemetry>::range_append(
+    ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+  const size_type n = std::distance(first, last);
+  if (attributes_.capacity_ - attributes_.size_ < n && own_element(first)) {
+    range_insert(end(), first, last, std::forward_iterator_tag());
+    return;
+  }
+  const size_type old_size = attributes_.size_;
+  grow_for(n);
+  try {
+    for (; first != last; ++first) {
+      emplace_back_unchecked(*first);
+    }
+  } catch (...) {
+    erase_at_end(begin() + old_size, end());
+    throw;
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<class Generator>
+void vector<T, Alloc, Guarantee, Telemetry>::append_n(vector::size_type n,
+                                                      Generator gen) {
+  const size_type old_size = attributes_.size_;
+  grow_for(n);
+  try {
+    for (size_type i = 0; i < n; ++i) {
+      emplace_back_unchecked(gen());
+    }
+  } catch (...) {
+    erase_at_end(begin() + old_size, end());
+    throw;
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::pop_back() {
   --attributes_.size_;
-  attributes_.alloc_.destroy(attributes_.data_ + attributes_.size_);
+  alloc_traits::destroy(attributes_.alloc_,
+                        attributes_.data_ + attributes_.size_);
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::append_value_end(vector::field &storage,
-                                        size_type append_size,
-                                        const value_type &x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::append_value_end(
+    vector::field &storage, size_type append_size, const value_type &x) {
   for (size_type i = 0; i < append_size; ++i) {
     try {
-      storage.alloc_.construct(storage.data_ + storage.size_ + i, x);
+      alloc_traits::construct(storage.alloc_,
+                              storage.data_ + storage.size_ + i, x);
     } catch (...) {
       for (; i > 0; --i) {
-        storage.alloc_.destroy(storage.data_ + storage.size_ + i);
+        alloc_traits::destroy(storage.alloc_,
+                              storage.data_ + storage.size_ + i);
       }
       throw;
     }
   }
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::move_range(vector::iterator position,
-                                  vector::size_type n) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::move_range(
+    vector::iterator position, vector::size_type n) {
   for (size_type i = 0; i < n; ++i) {
     try {
-      attributes_.alloc_.construct(attributes_.data_ + attributes_.size_ + i,
+      alloc_traits::construct(attributes_.alloc_,
+                              attributes_.data_ + attributes_.size_ + i,
       std::move_if_noexcept(attributes_.data_[attributes_.size_ + i - 1]));
     } catch (...) {
       for (; i > 0; --i) {
-        attributes_.alloc_.destroy(attributes_.data_ + attributes_.size_ + i);
-        throw;
+        alloc_traits::destroy(attributes_.alloc_,
+                              attributes_.data_ + attributes_.size_ + i - 1);
       }
+      throw;
     }
   }
   std::move_backward(position, end() - 1, end() + n - 1);
+  Telemetry::moved(n + (end() - 1 - position));
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::move_old_data(vector::field &storage,
-                                     vector::iterator position,
-                                     vector::size_type n) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::move_old_data(
+    vector::field &storage, vector::iterator position, vector::size_type n) {
   difference_type offset = position - begin();
   try {
     uninitialized_move(begin(), position, storage);
@@ -875,11 +1437,11 @@ void vector<T, Alloc>::move_old_data(vector::field &storage,
   storage.data_ -= offset + n;
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
-                                          vector::const_iterator position,
-                                          vector::size_type n,
-                                          const value_type &x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::insert(
+        vector::const_iterator position, vector::size_type n,
+        const value_type &x) {
   if (attributes_.size_ + n > max_size()) {
     throw ft::length_error("vector");
   }
@@ -887,6 +1449,14 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
   if (!n) {
     return (iterator(p));
   }
+  // a relocation would leave x dangling if it is one of the elements
+  if (attributes_.capacity_ < attributes_.size_ + n && !own_element(&x)) {
+    const difference_type offset = position - begin();
+    if (expand_storage(get_new_capacity(n))) {
+      position = begin() + offset;
+      p = attributes_.data_ + offset;
+    }
+  }
   if (attributes_.capacity_ >= attributes_.size_ + n) {
     if (position == end()) {
       append_value_end(attributes_, n, x);
@@ -904,54 +1474,102 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
     fill_initialize(new_storage, x, n, position - begin());
     move_old_data(new_storage, iterator(p), n);
     p = new_storage.data_ + (position - begin());
+    Telemetry::reallocated(new_storage.capacity_);
     destroy_storage(attributes_, 0);
     attributes_ = std::move(new_storage);
   }
   attributes_.size_ += n;
   return (iterator(p));
 }
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
-                                          vector::const_iterator position,
-                                          const value_type &x) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::insert(
+        vector::const_iterator position, const value_type &x) {
   return insert(position, 1, x);
 }
 
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename InputIterator>
-void vector<T, Alloc>::append_range_end(vector::field &storage,
-                                        size_type append_size,
-                                        InputIterator first) {
+void vector<T, Alloc, Guarantee, Telemetry>::append_range_end(
+    vector::field &storage, size_type append_size, InputIterator first) {
   for (size_type i = 0; i < append_size; ++i, ++first) {
     try {
-      storage.alloc_.construct(storage.data_ + storage.size_ + i, *first);
+      alloc_traits::construct(storage.alloc_,
+                              storage.data_ + storage.size_ + i, *first);
     } catch (...) {
       for (; i > 0; --i) {
-        storage.alloc_.destroy(storage.data_ + storage.size_ + i);
+        alloc_traits::destroy(storage.alloc_,
+                              storage.data_ + storage.size_ + i);
       }
       throw;
     }
   }
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename InputIterator>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::insert(
+        vector::const_iterator position, InputIterator first,
+        InputIterator last,
+        typename std::enable_if<!std::numeric_limits<
+            InputIterator>::is_specialized>::type *) {
+  return range_insert(position, first, last,
+      typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+//  appends the input, then rotates it into place
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename InputIterator>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
-                                  vector::const_iterator position,
-                                  InputIterator first,
-                                  InputIterator last,
-                                  typename std::enable_if<!std::numeric_limits<
-                                      InputIterator>::is_specialized>::type *) {
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::range_insert(
+        vector::const_iterator position, InputIterator first,
+        InputIterator last, std::input_iterator_tag) {
+  const difference_type offset = position - begin();
+  const size_type old_size = attributes_.size_;
+  try {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  } catch (...) {
+    erase_at_end(begin() + old_size, end());
+    throw;
+  }
+  std::rotate(attributes_.data_ + offset, attributes_.data_ + old_size,
+              attributes_.data_ + attributes_.size_);
+  return begin() + offset;
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename ForwardIterator>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::range_insert(
+        vector::const_iterator position, ForwardIterator first,
+        ForwardIterator last, std::forward_iterator_tag) {
   pointer p = attributes_.data_ + (position - begin());
   difference_type n = std::distance(first, last);
   if (n < 1) {
     return iterator(p);
   }
   if (attributes_.size_ + n > max_size()) throw ft::length_error("vector");
+  if (attributes_.capacity_ < attributes_.size_ + n && !own_element(first)) {
+    const difference_type offset = position - begin();
+    if (expand_storage(get_new_capacity(n))) {
+      position = begin() + offset;
+      p = attributes_.data_ + offset;
+    }
+  }
   if (attributes_.capacity_ >= attributes_.size_ + n) {
     if (position == end()) {
       append_range_end(attributes_, n, first);
+    } else if (overwrite_in_place<decltype(*first)>()) {
+      move_range(iterator(p), n);
+      attributes_.size_ += n;
+      for (pointer iter = p; first != last; ++first, ++iter) {
+        *iter = *first;
+      }
+      return iterator(p);
     } else {
       vector copy_v(first, last);
       move_range(iterator(p), n);
@@ -966,6 +1584,7 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
     range_initialize(new_storage, first, last, position - begin());
     move_old_data(new_storage, iterator(p), n);
     p = new_storage.data_ + (position - begin());
+    Telemetry::reallocated(new_storage.capacity_);
     destroy_storage(attributes_, 0);
     attributes_ = std::move(new_storage);
   }
@@ -973,83 +1592,95 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
   return (iterator(p));
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
-                                          vector::const_iterator position,
-                                          value_type &&x) {
-  return emplace(position, std::forward<value_type>(x));
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::insert(
+        vector::const_iterator position, value_type &&x) {
+  if (position == end() || attributes_.capacity_ == attributes_.size_) {
+    return emplace(position, std::move(x));
+  }
+  pointer p = attributes_.data_ + (position - begin());
+  move_range(iterator(p), 1);
+  *p = std::move(x);
+  ++attributes_.size_;
+  return iterator(p);
 }
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
-                                          vector::const_iterator position,
-                                          std::initializer_list<value_type> l) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::insert(
+        vector::const_iterator position, std::initializer_list<value_type> l) {
   return insert(position, l.begin(), l.end());
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(
-                                         vector::iterator first,
-                                         vector::iterator last) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::erase(
+        vector::iterator first, vector::iterator last) {
   pointer p = attributes_.data_ + (first - begin());
   if (first != last) {
     std::move(last, end(), begin() + (first.base() - attributes_.data_));
     difference_type n = last - first;
     for (; n; --n) {
-      attributes_.alloc_.destroy(attributes_.data_ + attributes_.size_ - 1);
+      alloc_traits::destroy(attributes_.alloc_,
+                            attributes_.data_ + attributes_.size_ - 1);
       --attributes_.size_;
     }
   }
   return iterator(p);
 }
 
-template<class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(
-                                                    vector::iterator position) {
+template<class T, class Alloc, class Guarantee, class Telemetry>
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::erase(vector::iterator position) {
   return erase(position, position + 1);
 }
 
-template<class T, class Alloc>
-void vector<T, Alloc>::swap(vector &x) {
-  std::swap(attributes_.data_, x.attributes_.data_);
-  std::swap(attributes_.capacity_, x.attributes_.capacity_);
-  std::swap(attributes_.size_, x.attributes_.size_);
-  std::swap(attributes_.alloc_, x.attributes_.alloc_);
+template<class T, class Alloc, class Guarantee, class Telemetry>
+void vector<T, Alloc, Guarantee, Telemetry>::swap(vector &x) {
+  attributes_.swap(x.attributes_);
+  ft::propagate_on_swap(attributes_.alloc_, x.attributes_.alloc_);
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename... Args>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(
-                                                vector::const_iterator position,
-                                                Args &&... args) {
+typename vector<T, Alloc, Guarantee, Telemetry>::iterator
+    vector<T, Alloc, Guarantee, Telemetry>::emplace(
+        vector::const_iterator position, Args &&... args) {
   if (attributes_.size_ + 1 > max_size()) throw ft::length_error("vector");
   pointer p = attributes_.data_ + (position - begin());
   if (attributes_.capacity_ >= attributes_.size_ + 1) {
     if (position == end()) {
       try {
-        attributes_.alloc_.construct(attributes_.data_ + attributes_.size_,
-                                     std::forward<Args>(args) ...);
+        alloc_traits::construct(attributes_.alloc_,
+                                attributes_.data_ + attributes_.size_,
+                                std::forward<Args>(args) ...);
       } catch (...) {
-        attributes_.alloc_.destroy(attributes_.data_ + attributes_.size_);
+        alloc_traits::destroy(attributes_.alloc_,
+                              attributes_.data_ + attributes_.size_);
         throw;
       }
     } else {
-      value_type copy_value(args ...);
+      // args may refer to an element that the shift moves
+      value_type value(std::forward<Args>(args) ...);
       move_range(iterator(p), 1);
-      *p = copy_value;
+      *p = std::move(value);
     }
   } else {
     field new_storage(nullptr, attributes_.size_, get_new_capacity(1),
                       attributes_.alloc_);
     initialize_storage(new_storage);
     try {
-      new_storage.alloc_.construct(new_storage.data_ + (position - begin()),
-                                   std::forward<Args>(args) ...);
+      alloc_traits::construct(new_storage.alloc_,
+                              new_storage.data_ + (position - begin()),
+                              std::forward<Args>(args) ...);
     } catch (...) {
-      new_storage.alloc_.destroy(new_storage.data_ + new_storage.size_);
+      alloc_traits::destroy(new_storage.alloc_,
+                            new_storage.data_ + new_storage.size_);
       throw;
     }
     move_old_data(new_storage, iterator(p), 1);
     p = new_storage.data_ + (position - begin());
+    Telemetry::reallocated(new_storage.capacity_);
     destroy_storage(attributes_, 0);
     attributes_ = std::move(new_storage);
   }
@@ -1057,54 +1688,87 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(
   return (iterator(p));
 }
 
-template<class T, class Alloc>
+template<class T, class Alloc, class Guarantee, class Telemetry>
 template<typename... Args>
-void vector<T, Alloc>::emplace_back(Args &&... args) {
-  emplace(end(), std::forward<Args>(args) ...);
+void vector<T, Alloc, Guarantee, Telemetry>::emplace_back(Args &&... args) {
+  if (attributes_.capacity_ != attributes_.size_) {
+    alloc_traits::construct(attributes_.alloc_,
+                            attributes_.data_ + attributes_.size_,
+                            std::forward<Args>(args) ...);
+    ++attributes_.size_;
+  } else {
+    realloc_append(std::forward<Args>(args) ...);
+  }
+}
+
+template<class T, class Alloc, class Guarantee, class Telemetry>
+template<typename... Args>
+void vector<T, Alloc, Guarantee, Telemetry>::emplace_back_unchecked(
+    Args &&... args) {
+  alloc_traits::construct(attributes_.alloc_,
+                          attributes_.data_ + attributes_.size_,
+                          std::forward<Args>(args) ...);
+  ++attributes_.size_;
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-bool operator==(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+bool operator==(const vector<T, Alloc, Guarantee, Telemetry> &left,
+                const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return(left.size() == right.size() &&
   std::equal(left.begin(), left.end(), right.begin()));
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-bool operator!=(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+bool operator!=(const vector<T, Alloc, Guarantee, Telemetry> &left,
+                const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return !(left == right);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-bool operator<(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+bool operator<(const vector<T, Alloc, Guarantee, Telemetry> &left,
+               const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return std::lexicographical_compare(left.begin(), left.end(), right.begin(),
                                       right.end());
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-bool operator>(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+bool operator>(const vector<T, Alloc, Guarantee, Telemetry> &left,
+               const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return right < left;
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-bool operator<=(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+bool operator<=(const vector<T, Alloc, Guarantee, Telemetry> &left,
+                const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return !(right < left);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-bool operator>=(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+bool operator>=(const vector<T, Alloc, Guarantee, Telemetry> &left,
+                const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return !(left < right);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Guarantee, class Telemetry>
 inline
-void swap(const vector<T,Alloc>& left, const vector<T,Alloc>& right) {
+void swap(const vector<T, Alloc, Guarantee, Telemetry> &left,
+          const vector<T, Alloc, Guarantee, Telemetry> &right) {
   return left.swap(right);
 }
 
+namespace pmr {
+
+template<class T, class Guarantee = ft::vector_strong_guarantee,
+         class Telemetry = ft::vector_no_telemetry>
+using vector = ft::vector<T, ft::pmr::polymorphic_allocator<T>, Guarantee,
+                          Telemetry>;
+
+}
+
 }